@@ -11,6 +11,8 @@
 #define RADIOINTERFEROMETERY_DAYSEC ERFA_DAYSEC
 #define RADIOINTERFEROMETERY_PI 3.14159265358979323846
 #define RADIOINTERFEROMETERY_C 299792458.0
+// radians per (UT1) second, the rate of the Earth rotation angle
+#define RADIOINTERFEROMETERY_EARTH_ROTATION_RATE (1.00273781191135448*2*RADIOINTERFEROMETERY_PI/RADIOINTERFEROMETERY_DAYSEC)
 
 enum position_frames {
 	FRAME_ENU,
@@ -19,6 +21,35 @@ enum position_frames {
 	FRAME_UVW
 };
 
+/*
+ * The baselines of N antennas, autos included, number N(N+1)/2.
+ * BASELINE_ORDERING_UPPER_TRIANGULAR: (0,0), (0,1), ... (0,N-1), (1,1), ...
+ *   i.e. antenna1 <= antenna2, as the baselines of each time in the
+ *   baseline-time axis of UVH5 and CASA measurement sets.
+ * BASELINE_ORDERING_TRIANGULAR_BY_COLUMN: (0,0), (0,1), (1,1), (0,2), ...
+ *   as output by correlators accumulating antenna by antenna.
+ */
+enum baseline_orderings {
+	BASELINE_ORDERING_UPPER_TRIANGULAR,
+	BASELINE_ORDERING_TRIANGULAR_BY_COLUMN
+};
+
+/*
+ * The accuracy tiers of the precession-nutation (see `calc_precession_nutation_t`).
+ */
+enum precession_nutation_accuracies {
+	PRECESSION_NUTATION_IAU2006A,
+	PRECESSION_NUTATION_IAU2000B,
+	PRECESSION_NUTATION_INTERPOLATED
+};
+
+enum rotation_kernels {
+	ROTATION_KERNEL_SCALAR,
+	ROTATION_KERNEL_AVX2,
+	ROTATION_KERNEL_AVX512,
+	ROTATION_KERNEL_NEON
+};
+
 double calc_rad_from_degree(double deg);
 
 double calc_julian_date_from_unix_sec(double unix_sec);
@@ -42,6 +73,34 @@ double calc_julian_date_from_guppi_param(
 	const size_t pktidx
 );
 
+/*
+ * Two-part (integer day, fraction of the day) dates of the start of each block
+ * `pktidx[i]`, which keep the sub-microsecond timing that a single double
+ * loses at the magnitude of Julian dates (some 40 microseconds). The pairs
+ * pass directly to the `_with_two_part_date` functions as `date1, date2`.
+ */
+void calc_julian_dates_from_guppi_param(
+	const double tbin,
+	const size_t sampleperblk,
+	const size_t piperblk,
+	const size_t synctime,
+	const size_t* pktidx,
+	size_t count,
+	double* jd_day,
+	double* jd_fraction
+);
+
+void calc_modified_julian_dates_from_guppi_param(
+	const double tbin,
+	const size_t sampleperblk,
+	const size_t piperblk,
+	const size_t synctime,
+	const size_t* pktidx,
+	size_t count,
+	double* mjd_day,
+	double* mjd_fraction
+);
+
 void calc_ha_dec_rad(
 	double ra_rad,
 	double dec_rad,
@@ -54,6 +113,19 @@ void calc_ha_dec_rad(
 	double* declination_rad
 );
 
+void calc_ha_dec_rad_with_two_part_date(
+	double ra_rad,
+	double dec_rad,
+	double longitude_rad,
+	double latitude_rad,
+	double altitude,
+	double date1,
+	double date2,
+	double dut1,
+	double* hour_angle_rad,
+	double* declination_rad
+);
+
 double calc_lst(double timemjd, double dut1);
 
 float calc_hypotenuse_f(float* position, int dims);
@@ -70,6 +142,56 @@ void calc_independent_astrom(
 		eraASTROM* astrom
 );
 
+void calc_independent_astrom_with_two_part_date(
+	double longitude_rad,
+	double latitude_rad,
+	double altitude,
+	double date1,
+	double date2,
+	double dut1,
+	eraASTROM* astrom
+);
+
+/*
+ * The star-independent astrometry parameters of a site, reused for a window of
+ * time: within the window only the Earth rotation angle is advanced, beyond it
+ * the parameters are recomputed. The staleness of the remaining parameters
+ * (mostly the diurnal aberration, then the Earth's orbital velocity and
+ * precession-nutation) amounts to about 25 microarcseconds per second of window.
+ * UT1-UTC only enters the Earth rotation angle, advanced with the current
+ * value, so a changing (e.g. interpolated) UT1-UTC keeps the window.
+ */
+typedef struct {
+	double longitude_rad;
+	double latitude_rad;
+	double altitude;
+	double window_days;
+	double anchor_timemjd; // of the star-independent parameters, NaN if none
+	double anchor_date2; // the second part of the anchor's two-part date
+	eraASTROM astrom;
+} calc_astrom_cache_t;
+
+void calc_astrom_cache_init(
+	calc_astrom_cache_t* cache,
+	double longitude_rad,
+	double latitude_rad,
+	double altitude,
+	double window_seconds
+);
+
+eraASTROM* calc_astrom_cache_update(
+	calc_astrom_cache_t* cache,
+	double timemjd,
+	double dut1
+);
+
+eraASTROM* calc_astrom_cache_update_with_two_part_date(
+	calc_astrom_cache_t* cache,
+	double date1,
+	double date2,
+	double dut1
+);
+
 void calc_ha_dec_rad_with_independent_astrom(
 	double ra_rad,
 	double dec_rad,
@@ -78,6 +200,15 @@ void calc_ha_dec_rad_with_independent_astrom(
 	double* declination_rad
 );
 
+void calc_ha_dec_rad_batch_with_independent_astrom(
+	const double* ra_rad,
+	const double* dec_rad,
+	size_t count,
+	eraASTROM* astrom,
+	double* hour_angle_rad,
+	double* declination_rad
+);
+
 void calc_ecef_from_lla(
 	double ecef[3],
 	const double longitude_rad,
@@ -86,6 +217,127 @@ void calc_ecef_from_lla(
 	const geodesy_t* geo
 );
 
+int calc_rotation_kernel_supported(enum rotation_kernels kernel);
+
+void calc_positions_transform_with_kernel(
+	double* positions,
+	int position_count,
+	const double pre_translation[3],
+	const double rotation[3][3],
+	const double post_translation[3],
+	enum rotation_kernels kernel
+);
+
+void calc_positions_transform(
+	double* positions,
+	int position_count,
+	const double pre_translation[3],
+	const double rotation[3][3],
+	const double post_translation[3]
+);
+
+void calc_positions_rotate_with_kernel(
+	double* positions,
+	int position_count,
+	const double rotation[3][3],
+	enum rotation_kernels kernel
+);
+
+void calc_positions_rotate(
+	double* positions,
+	int position_count,
+	const double rotation[3][3]
+);
+
+/*
+ * `position' = rotation*(position + pre_translation) + post_translation`, with
+ * any permutation of the axes included in `rotation`. Composing keeps the
+ * first transform's `pre_translation`, so that the translation of ECEF
+ * positions to the array centre is not folded into the rotation, where it
+ * would cost the precision of the large ECEF coordinates.
+ */
+typedef struct {
+	double pre_translation[3];
+	double rotation[3][3];
+	double post_translation[3];
+} calc_frame_transform_t;
+
+void calc_frame_transform_identity(calc_frame_transform_t* transform);
+
+/*
+ * transform = first followed by second.
+ */
+void calc_frame_transform_compose(
+	calc_frame_transform_t* transform,
+	const calc_frame_transform_t* first,
+	const calc_frame_transform_t* second
+);
+
+/*
+ * Transforms the positions in a single pass.
+ */
+void calc_frame_transform_apply(
+	const calc_frame_transform_t* transform,
+	double* positions,
+	int position_count
+);
+
+void calc_frame_transform_to_xyz_from_ecef(
+	calc_frame_transform_t* transform,
+	double longitude_rad,
+	double latitude_rad,
+	double altitude
+);
+
+void calc_frame_transform_to_ecef_from_xyz(
+	calc_frame_transform_t* transform,
+	double longitude_rad,
+	double latitude_rad,
+	double altitude
+);
+
+void calc_frame_transform_to_xyz_from_enu(
+	calc_frame_transform_t* transform,
+	double longitude_rad,
+	double latitude_rad,
+	double altitude // Not used
+);
+
+void calc_frame_transform_to_enu_from_xyz(
+	calc_frame_transform_t* transform,
+	double longitude_rad,
+	double latitude_rad,
+	double altitude // Not used
+);
+
+void calc_frame_transform_to_enu_from_ecef(
+	calc_frame_transform_t* transform,
+	double longitude_rad,
+	double latitude_rad,
+	double altitude
+);
+
+void calc_frame_transform_to_ecef_from_enu(
+	calc_frame_transform_t* transform,
+	double longitude_rad,
+	double latitude_rad,
+	double altitude
+);
+
+void calc_frame_transform_to_uvw_from_enu(
+	calc_frame_transform_t* transform,
+	double hour_angle_rad,
+	double declination_rad,
+	double latitude_rad
+);
+
+void calc_frame_transform_to_uvw_from_xyz(
+	calc_frame_transform_t* transform,
+	double hour_angle_rad,
+	double declination_rad,
+	double longitude_rad
+);
+
 void calc_position_to_xyz_frame_from_ecef(
 	double* positions,
 	int position_count,
@@ -160,6 +412,578 @@ void calc_position_delays(
 	double* delays
 );
 
+void calc_positions_relative_f(
+	const double* positions,
+	int position_count,
+	const double centre[3],
+	float* positions_relative
+);
+
+void calc_frame_transform_apply_f(
+	const calc_frame_transform_t* transform,
+	float* positions,
+	int position_count
+);
+
+void calc_position_delays_f(
+	float* positions_xyz_in_uvw_out,
+	int position_count,
+	int reference_position_index,
+	double hour_angle_rad,
+	double declination_rad,
+	double longitude_rad,
+	float* delays
+);
+
+void calc_position_delays_with_rates(
+	double* positions_xyz_in_uvw_out,
+	int position_count,
+	int reference_position_index,
+	double hour_angle_rad,
+	double declination_rad,
+	double longitude_rad,
+	double* delays,
+	double* delay_rates,
+	double* delay_accelerations
+);
+
+// 256 positions of xyz doubles occupy 6 KiB
+#define CALC_DELAY_MATRIX_BLOCK_POSITIONS 256
+// 64 beams of coefficients occupy 1.5 KiB of stack
+#define CALC_DELAY_MATRIX_BLOCK_BEAMS 64
+
+void calc_delay_matrix(
+	const double* positions_xyz,
+	int position_count,
+	int reference_position_index,
+	const double* hour_angle_rad,
+	const double* declination_rad,
+	int beam_count,
+	double longitude_rad,
+	double* delays
+);
+
+void calc_delay_matrix_f(
+	const double* positions_xyz,
+	int position_count,
+	int reference_position_index,
+	const double* hour_angle_rad,
+	const double* declination_rad,
+	int beam_count,
+	double longitude_rad,
+	float* delays
+);
+
+void calc_delay_matrix_workspace(
+	const double* positions_xyz,
+	int position_count,
+	int reference_position_index,
+	const double* hour_angle_rad,
+	const double* declination_rad,
+	int beam_count,
+	double longitude_rad,
+	double* coefficients,
+	double* delays
+);
+
+size_t calc_baseline_count(int antenna_count);
+
+void calc_baseline_antennas(
+	int antenna_count,
+	enum baseline_orderings ordering,
+	int* antenna1,
+	int* antenna2
+);
+
+/*
+ * Baseline UVWs (antenna2 - antenna1) of antenna UVWs, computed across
+ * `thread_count` threads, each writing a contiguous run of baselines. The
+ * `baseline_lengths` argument may be NULL. For a baseline-time axis, offset
+ * `baseline_uvw` by `3*time_index*calc_baseline_count(antenna_count)`. The
+ * calling thread computes all baselines if the threads' bookkeeping cannot be
+ * allocated.
+ */
+void calc_baseline_uvw(
+	const double* antenna_uvw,
+	int antenna_count,
+	enum baseline_orderings ordering,
+	int thread_count,
+	double* baseline_uvw,
+	double* baseline_lengths
+);
+
+/*
+ * As `calc_baseline_uvw`, with the antenna UVWs from `positions_xyz` (left
+ * intact) per `calc_position_to_uvw_frame_from_xyz`, returning 6 if their
+ * scratch cannot be allocated.
+ */
+int calc_baseline_uvw_from_xyz(
+	const double* positions_xyz,
+	int antenna_count,
+	double hour_angle_rad,
+	double declination_rad,
+	double longitude_rad,
+	enum baseline_orderings ordering,
+	int thread_count,
+	double* baseline_uvw,
+	double* baseline_lengths
+);
+
+#define CALC_UVW_SERIES_REANCHOR_INTERVAL 64
+
+/*
+ * The UVW positions of `positions_xyz` (left intact) at each of `time_count`
+ * hour angles `hour_angle_start_rad + t*hour_angle_step_rad`, in
+ * `uvw[(t*position_count + position)*3 + axis]`. The time steps are split
+ * across `thread_count` threads, or all taken by the calling thread if the
+ * threads' bookkeeping cannot be allocated.
+ *
+ * Rather than evaluating trigonometry each time step, the rotation is advanced
+ * by angle addition, and re-anchored with exact trigonometry every
+ * `reanchor_interval` time steps (CALC_UVW_SERIES_REANCHOR_INTERVAL if less
+ * than 1). The rounding of the recurrence grows by some 2^-53 per step, so
+ * the UVWs deviate from `calc_position_to_uvw_frame_from_xyz` by less than
+ * `reanchor_interval * 2^-50 * |xyz|`: 60 picometres at 1 km, by default.
+ */
+void calc_uvw_time_series(
+	const double* positions_xyz,
+	int position_count,
+	double hour_angle_start_rad,
+	double hour_angle_step_rad,
+	int time_count,
+	double declination_rad,
+	double longitude_rad,
+	int reanchor_interval,
+	int thread_count,
+	double* uvw
+);
+
+/*
+ * An observatory's static geometry, computed once by `calc_site_init` and
+ * read only thereafter (so it may be shared across threads): the ECEF of its
+ * LLA on its ellipsoid and the transforms between its array-centred frames
+ * and ECEF, which hold the trigonometry of its latitude and longitude. The
+ * `_with_site` functions take it in place of the longitude, latitude and
+ * altitude.
+ *
+ * ERFA's astrometry places the site on WGS84 regardless of `geodesy`.
+ */
+typedef struct {
+	double longitude_rad;
+	double latitude_rad;
+	double altitude;
+	geodesy_t geodesy;
+	double ecef[3];
+	calc_frame_transform_t xyz_from_ecef;
+	calc_frame_transform_t ecef_from_xyz;
+	calc_frame_transform_t enu_from_xyz;
+	calc_frame_transform_t xyz_from_enu;
+	calc_frame_transform_t enu_from_ecef;
+	calc_frame_transform_t ecef_from_enu;
+} calc_site_t;
+
+void calc_site_init(
+	calc_site_t* site,
+	double longitude_rad,
+	double latitude_rad,
+	double altitude,
+	const geodesy_t* geodesy
+);
+
+void calc_position_to_xyz_frame_from_ecef_with_site(
+	double* positions,
+	int position_count,
+	const calc_site_t* site
+);
+
+void calc_position_to_ecef_frame_from_xyz_with_site(
+	double* positions,
+	int position_count,
+	const calc_site_t* site
+);
+
+void calc_position_to_xyz_frame_from_enu_with_site(
+	double* positions,
+	int position_count,
+	const calc_site_t* site
+);
+
+void calc_position_to_enu_frame_from_xyz_with_site(
+	double* positions,
+	int position_count,
+	const calc_site_t* site
+);
+
+void calc_position_to_enu_frame_from_ecef_with_site(
+	double* positions,
+	int position_count,
+	const calc_site_t* site
+);
+
+void calc_position_to_ecef_frame_from_enu_with_site(
+	double* positions,
+	int position_count,
+	const calc_site_t* site
+);
+
+void calc_position_to_uvw_frame_from_xyz_with_site(
+	double* positions,
+	int position_count,
+	double hour_angle_rad,
+	double declination_rad,
+	const calc_site_t* site
+);
+
+void calc_position_to_uvw_frame_from_enu_with_site(
+	double* positions,
+	int position_count,
+	double hour_angle_rad,
+	double declination_rad,
+	const calc_site_t* site
+);
+
+void calc_position_delays_with_site(
+	double* positions_xyz_in_uvw_out,
+	int position_count,
+	int reference_position_index,
+	double hour_angle_rad,
+	double declination_rad,
+	const calc_site_t* site,
+	double* delays
+);
+
+void calc_delay_matrix_with_site(
+	const double* positions_xyz,
+	int position_count,
+	int reference_position_index,
+	const double* hour_angle_rad,
+	const double* declination_rad,
+	int beam_count,
+	const calc_site_t* site,
+	double* delays
+);
+
+void calc_independent_astrom_with_site(
+	const calc_site_t* site,
+	double date1,
+	double date2,
+	double dut1,
+	eraASTROM* astrom
+);
+
+void calc_ha_dec_rad_with_site(
+	double ra_rad,
+	double dec_rad,
+	const calc_site_t* site,
+	double date1,
+	double date2,
+	double dut1,
+	double* hour_angle_rad,
+	double* declination_rad
+);
+
+void calc_astrom_cache_init_with_site(
+	calc_astrom_cache_t* cache,
+	const calc_site_t* site,
+	double window_seconds
+);
+
+/*
+ * The state of a beamformer tracking beams from a site: its antennas (XYZ),
+ * the RA/Dec of its beams, its source of UT1-UTC (an IERS table, or a fixed
+ * value if the table is NULL) and the results at the last date it was
+ * advanced to. The antenna positions and beams are copies, the site's
+ * transforms are computed once, the IERS lookup and astrometry are renewed
+ * incrementally, so each advance only recomputes what changed.
+ */
+typedef struct {
+	calc_site_t site;
+	int antenna_count;
+	double* positions_xyz;
+	int reference_antenna_index;
+	int beam_count;
+	double* beam_ra_rad;
+	double* beam_dec_rad;
+	bool* beam_changed; // since the last advance
+	const radiointerferometry_iers_table_t* iers_table;
+	radiointerferometry_iers_cursor_t iers_cursor;
+	double dut1; // used in the absence of `iers_table`
+	calc_astrom_cache_t astrom_cache;
+	// at the last advance, NaN if none
+	double date1;
+	double date2;
+	double dut1_current;
+	double* hour_angle_rad; // [beam]
+	double* declination_rad; // [beam]
+	double* delay_coefficients; // [beam][3], scratch of `calc_delay_matrix_workspace`
+	double* delays; // [beam][antenna]
+} calc_tracking_session_t;
+
+int calc_tracking_session_init(
+	calc_tracking_session_t* session,
+	const calc_site_t* site,
+	const double* positions_xyz,
+	int antenna_count,
+	int reference_antenna_index,
+	const double* ra_rad,
+	const double* dec_rad,
+	int beam_count,
+	const radiointerferometry_iers_table_t* iers_table,
+	double dut1,
+	double astrom_window_seconds
+);
+
+void calc_tracking_session_free(
+	calc_tracking_session_t* session
+);
+
+void calc_tracking_session_set_beam(
+	calc_tracking_session_t* session,
+	int beam_index,
+	double ra_rad,
+	double dec_rad
+);
+
+int calc_tracking_session_advance(
+	calc_tracking_session_t* session,
+	double date1,
+	double date2
+);
+
+const double* calc_tracking_session_get_delays(
+	const calc_tracking_session_t* session
+);
+
+/*
+ * A thread computing the delays of a tracking session ahead of time, into a
+ * lock-free single-producer single-consumer ring, so that a real-time consumer
+ * polls for them without ever blocking on the astrometry.
+ */
+typedef struct {
+	calc_tracking_session_t session; // of the producer thread
+	double start_date1;
+	double start_date2;
+	double step_seconds;
+	long lead_sets;
+	int depth;
+	double* _slot_delays; // [depth][beam][antenna]
+	long* _slot_index;    // [depth], the set in the slot
+	unsigned long _head;  // sets produced into the ring
+	unsigned long _tail;  // the consumer's set
+	long _consumer_index; // of the consumer's last poll
+	unsigned long _produced;
+	unsigned long _underruns;
+	int _status;
+	bool _running;
+	pthread_t _thread;
+} calc_delay_producer_t;
+
+int calc_delay_producer_start(
+	calc_delay_producer_t* producer,
+	const calc_site_t* site,
+	const double* positions_xyz,
+	int antenna_count,
+	int reference_antenna_index,
+	const double* ra_rad,
+	const double* dec_rad,
+	int beam_count,
+	const radiointerferometry_iers_table_t* iers_table,
+	double dut1,
+	double astrom_window_seconds,
+	double start_date1,
+	double start_date2,
+	double step_seconds,
+	double lead_seconds,
+	int depth
+);
+
+void calc_delay_producer_stop(
+	calc_delay_producer_t* producer
+);
+
+int calc_delay_producer_poll(
+	calc_delay_producer_t* producer,
+	double date1,
+	double date2,
+	const double** delays
+);
+
+void calc_delay_producer_counters(
+	calc_delay_producer_t* producer,
+	unsigned long* produced,
+	unsigned long* underruns,
+	int* status
+);
+
+#define CALC_PRECESSION_NUTATION_ANCHOR_SECONDS 900.0
+
+/*
+ * The precession-nutation of time-dependent functions, to one of the tiers:
+ * - PRECESSION_NUTATION_IAU2006A: the full IAU 2006/2000A series (eraPnm06a,
+ *   eraS06), exactly as the functions without a tier.
+ * - PRECESSION_NUTATION_IAU2000B: the truncated IAU 2000B series (eraPnm00b,
+ *   eraS00). Between 1995 and 2050, the CIP X and Y are within 1.5 mas of the
+ *   full series and s within 0.01 mas. The equation of the origins is within
+ *   4 mas, as it also takes the IAU 2000 rather than the P03 precession,
+ *   whose difference grows with the distance from J2000.
+ * - PRECESSION_NUTATION_INTERPOLATED: the full series at anchors every
+ *   `anchor_seconds`, linearly interpolated between. The curvature of the
+ *   nutation (dominated by its 13.66 and 9.13 day terms) is below 0.15 arcsec
+ *   per day squared, so the error is below `h^2/8 * 0.15 arcsec` for anchors
+ *   `h` days apart: 2 microarcseconds for the default 15 minutes, 33 at 1 hour.
+ *
+ * The interpolated tier keeps its anchors in the struct, which is therefore
+ * not to be shared across threads.
+ */
+typedef struct {
+	enum precession_nutation_accuracies accuracy;
+	double anchor_days;
+	double origin_date1; // of the anchors, NaN if none
+	double origin_date2;
+	long anchor_index; // of the lower anchor
+	double lower[4]; // x, y, s, eo
+	double upper[4];
+} calc_precession_nutation_t;
+
+void calc_precession_nutation_init(
+	calc_precession_nutation_t* precession_nutation,
+	enum precession_nutation_accuracies accuracy,
+	double anchor_seconds
+);
+
+void calc_precession_nutation_cip(
+	calc_precession_nutation_t* precession_nutation,
+	double date1,
+	double date2,
+	double* x,
+	double* y,
+	double* s,
+	double* eo
+);
+
+double calc_lst_with_precession_nutation(
+	calc_precession_nutation_t* precession_nutation,
+	double date1,
+	double date2
+);
+
+int calc_independent_astrom_with_precession_nutation(
+	calc_precession_nutation_t* precession_nutation,
+	double longitude_rad,
+	double latitude_rad,
+	double altitude,
+	double date1,
+	double date2,
+	double dut1,
+	double pm_x_rad,
+	double pm_y_rad,
+	eraASTROM* astrom,
+	double* eo
+);
+
+#define CALC_LST_MODEL_SPAN_SECONDS 3600.0
+
+/*
+ * The LST as linear in time over spans of `span_days`: the Earth rotation
+ * angle is exactly linear in UT1, and the correction to sidereal time (the
+ * equation of the origins) is interpolated linearly across the span, from
+ * `calc_lst` at either end. Each span thereby costs three `calc_lst` calls
+ * (one checking the model midway), and each LST within it a multiply-add.
+ * The correction, GST - ERA = -eo, is mostly the equation of the equinoxes
+ * `dpsi*cos(eps)`. Its curvature comes from the short-period nutation terms
+ * and stays below 0.1 arcsec per day squared, so the deviation from
+ * `calc_lst` is below `h^2/8 * 0.1 arcsec` for a span of `h` days. That is
+ * 0.1 nanoradians for an hour.
+ * `max_deviation_rad` reports the largest deviation seen by the checks.
+ */
+typedef struct {
+	double longitude_rad;
+	double span_days;
+	double anchor_date1; // NaN if none
+	double anchor_date2;
+	double base_rad; // at the anchor
+	double rate_rad_per_day;
+	double max_deviation_rad;
+	unsigned long anchor_count;
+} calc_lst_model_t;
+
+void calc_lst_model_init(
+	calc_lst_model_t* model,
+	double longitude_rad,
+	double span_seconds
+);
+
+void calc_lst_model_evaluate(
+	calc_lst_model_t* model,
+	double date1,
+	const double* date2,
+	size_t count,
+	double* lst
+);
+
+#define CALC_DELAY_MODEL_MAX_ORDER 16
+
+/*
+ * Per-position Chebyshev series of the geometric delay (as per
+ * `calc_position_delays`) over a window of time. The series of position `a`
+ * is `coefficients[a*coefficient_count + j]*T_j(x)` summed over `j`, with
+ * `x = 2*(timemjd - timemjd_start)/(timemjd_end - timemjd_start) - 1`.
+ */
+typedef struct {
+	int position_count;
+	int coefficient_count;
+	double timemjd_start;
+	double timemjd_end;
+	double* coefficients; // seconds
+	double max_residual; // seconds, over all positions
+} calc_delay_model_t;
+
+/*
+ * Fits the model at `order+1` Chebyshev nodes of the window, evaluating the
+ * geometry with `calc_ha_dec_rad` and `calc_position_delays`, then measures
+ * `max_residual` at the `order+2` extrema of the window (edges included).
+ * `positions_xyz` is not modified.
+ *
+ * Returns:
+ *  0: success
+ *  1: error `order` exceeds CALC_DELAY_MODEL_MAX_ORDER, or the window is empty.
+ *  6: error allocating memory, `model->coefficients` left NULL.
+ */
+int calc_delay_model_fit(
+	calc_delay_model_t* model,
+	const double* positions_xyz,
+	int position_count,
+	int reference_position_index,
+	double ra_rad,
+	double dec_rad,
+	double longitude_rad,
+	double latitude_rad,
+	double altitude,
+	double timemjd_start,
+	double timemjd_end,
+	double dut1,
+	int order
+);
+
+/*
+ * Delays (seconds), and optionally their rates (seconds per second) and
+ * accelerations (seconds per second squared), of each position at `timemjd`.
+ * The rate and acceleration arguments may be NULL.
+ */
+void calc_delay_model_evaluate(
+	const calc_delay_model_t* model,
+	double timemjd,
+	double* delays,
+	double* delay_rates,
+	double* delay_accelerations
+);
+
+void calc_delay_model_free(
+	calc_delay_model_t* model
+);
+
+size_t calc_itrs_icrs_frame_pos_angle_workspace_size(size_t count);
+
 int calc_itrs_icrs_frame_pos_angle(
     double* time_jd,
     double* app_ra_radians,
@@ -173,6 +997,33 @@ int calc_itrs_icrs_frame_pos_angle(
     double* pos_angle
 );
 
+int calc_itrs_icrs_frame_pos_angle_with_iers_table(
+    double* time_jd,
+    double* app_ra_radians,
+    double* app_dec_radians,
+    size_t count,
+	double longitude_rad,
+	double latitude_rad,
+	double altitude,
+    double offset_pos,
+    const radiointerferometry_iers_table_t* iers_table,
+    double* pos_angle
+);
+
+int calc_itrs_icrs_frame_pos_angle_with_iers_table_workspace(
+    double* time_jd,
+    double* app_ra_radians,
+    double* app_dec_radians,
+    size_t count,
+	double longitude_rad,
+	double latitude_rad,
+	double altitude,
+    double offset_pos,
+    const radiointerferometry_iers_table_t* iers_table,
+    void* workspace,
+    double* pos_angle
+);
+
 int calc_itrs_icrs_frame_pos_angle_with_pm_and_ut1_utc(
   double* time_jd,
   double* app_ra_radians,
@@ -188,4 +1039,69 @@ int calc_itrs_icrs_frame_pos_angle_with_pm_and_ut1_utc(
   double* pos_angle
 );
 
+int calc_itrs_icrs_frame_pos_angle_with_pm_and_ut1_utc_workspace(
+  double* time_jd,
+  double* app_ra_radians,
+  double* app_dec_radians,
+  double* pm_x_arcsec,
+  double* pm_y_arcsec,
+  double* ut1_utc_sec,
+  size_t count,
+  double longitude_rad,
+  double latitude_rad,
+  double altitude,
+  double offset_pos,
+  void* workspace,
+  double* pos_angle
+);
+
+int calc_itrs_icrs_frame_pos_angle_with_precession_nutation(
+  double* time_jd,
+  double* app_ra_radians,
+  double* app_dec_radians,
+  double* pm_x_arcsec,
+  double* pm_y_arcsec,
+  double* ut1_utc_sec,
+  size_t count,
+  double longitude_rad,
+  double latitude_rad,
+  double altitude,
+  double offset_pos,
+  calc_precession_nutation_t* precession_nutation,
+  void* workspace,
+  double* pos_angle
+);
+
+int calc_itrs_icrs_frame_pos_angle_with_iers_table_parallel(
+  double* time_jd,
+  double* app_ra_radians,
+  double* app_dec_radians,
+  size_t count,
+  double longitude_rad,
+  double latitude_rad,
+  double altitude,
+  double offset_pos,
+  const radiointerferometry_iers_table_t* iers_table,
+  int thread_count,
+  double* pos_angle,
+  int* status
+);
+
+int calc_itrs_icrs_frame_pos_angle_with_pm_and_ut1_utc_parallel(
+  double* time_jd,
+  double* app_ra_radians,
+  double* app_dec_radians,
+  double* pm_x_arcsec,
+  double* pm_y_arcsec,
+  double* ut1_utc_sec,
+  size_t count,
+  double longitude_rad,
+  double latitude_rad,
+  double altitude,
+  double offset_pos,
+  int thread_count,
+  double* pos_angle,
+  int* status
+);
+
 #endif // RADIOINTERFEROMETRY_C99_H_
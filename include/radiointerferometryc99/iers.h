@@ -47,7 +47,13 @@ Dn.d
 ********************************************************************************
 */
 
+#ifndef __RADIOINTERFEROMETRY_C99_IERS_H_
+#define __RADIOINTERFEROMETRY_C99_IERS_H_
+
+#include <pthread.h>
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
@@ -86,16 +92,318 @@ typedef struct
 * The return argument `record` is expected to have its `mjd` field populated with the 
 * date of the record to be read.
 *
+* Any of the IERS finals products can be read (finals2000A.all/.data/.daily and
+* the IAU1980 finals.all/.data/.daily), whatever their first date: the record is
+* located by bisection, in O(log n) reads. The IAU1980 products hold dPsi and
+* dEpsilon in the fields of dX and dY.
+*
 * Returns:
-*  -1: error record->mjd < 41684.0, predating IERS records.
+*  -1: error record->mjd precedes the first record.
 *  0: success
 *  1: error opening filepath
-*  2: error seeking to record, probably exceeding IERS records.
-*  3: error reading record, should not occur.
+*  2: error reading records.
+*  3: error reading record, not of the expected format.
 *  4: error reading subsequent record, could not interpolate, MJD clipped, probably exceeding IERS records.
 *  5: error interpolating, consequent record is not next day, sparse IERS records not expected.
 */
 int radiointerferometry_iers_get(
   const char* filepath,
   radiointerferometry_iers_record_t* record
-);
\ No newline at end of file
+);
+
+/*
+* Columns of an IERS table, in record order. The MJD is not a column, it is
+* implied by the index of the record: `mjd_start + index`.
+* Flags are stored as 0.0 (IERS) or 1.0 (Prediction).
+*/
+typedef enum {
+  RADIOINTERFEROMETRY_IERS_COLUMN_YEAR,
+  RADIOINTERFEROMETRY_IERS_COLUMN_MONTH,
+  RADIOINTERFEROMETRY_IERS_COLUMN_DAY,
+  RADIOINTERFEROMETRY_IERS_COLUMN_POLPMFLAG_A,
+  RADIOINTERFEROMETRY_IERS_COLUMN_PM_X_A,
+  RADIOINTERFEROMETRY_IERS_COLUMN_E_PM_X_A,
+  RADIOINTERFEROMETRY_IERS_COLUMN_PM_Y_A,
+  RADIOINTERFEROMETRY_IERS_COLUMN_E_PM_Y_A,
+  RADIOINTERFEROMETRY_IERS_COLUMN_UT1FLAG_A,
+  RADIOINTERFEROMETRY_IERS_COLUMN_UT1_UTC_A,
+  RADIOINTERFEROMETRY_IERS_COLUMN_E_UT1_UTC_A,
+  RADIOINTERFEROMETRY_IERS_COLUMN_LOD_A,
+  RADIOINTERFEROMETRY_IERS_COLUMN_E_LOD_A,
+  RADIOINTERFEROMETRY_IERS_COLUMN_NUTFLAG_A,
+  RADIOINTERFEROMETRY_IERS_COLUMN_DX_2000A_A,
+  RADIOINTERFEROMETRY_IERS_COLUMN_E_DX_2000A_A,
+  RADIOINTERFEROMETRY_IERS_COLUMN_DY_2000A_A,
+  RADIOINTERFEROMETRY_IERS_COLUMN_E_DY_2000A_A,
+  RADIOINTERFEROMETRY_IERS_COLUMN_PM_X_B,
+  RADIOINTERFEROMETRY_IERS_COLUMN_PM_Y_B,
+  RADIOINTERFEROMETRY_IERS_COLUMN_UT1_UTC_B,
+  RADIOINTERFEROMETRY_IERS_COLUMN_DX_2000A_B,
+  RADIOINTERFEROMETRY_IERS_COLUMN_DY_2000A_B,
+  RADIOINTERFEROMETRY_IERS_COLUMN_COUNT
+} radiointerferometry_iers_column_t;
+
+#define RADIOINTERFEROMETRY_IERS_COLUMN_MASK(column) (((uint32_t)1) << (column))
+#define RADIOINTERFEROMETRY_IERS_COLUMN_MASK_ALL (RADIOINTERFEROMETRY_IERS_COLUMN_MASK(RADIOINTERFEROMETRY_IERS_COLUMN_COUNT)-1)
+
+/*
+* An IERS file parsed once into memory, one contiguous array per column.
+* Records are daily, so the record of a given MJD is at index `mjd - mjd_start`.
+* Days absent from the file (e.g. a snippet of the full file) are NaN.
+*/
+typedef struct
+{
+  double mjd_start;     // MJD of the first record
+  size_t record_count;  // number of records behind each column
+  double* columns[RADIOINTERFEROMETRY_IERS_COLUMN_COUNT];
+  void* _storage;       // single allocation backing all of the columns
+  size_t _storage_mapping_size; // non-zero when `_storage` is a read-only mapping
+} radiointerferometry_iers_table_t;
+
+/*
+* Parses all of the records in filepath into `table`, which is to be released
+* with `radiointerferometry_iers_table_free`. As for `radiointerferometry_iers_get`,
+* any of the IERS finals products can be loaded.
+*
+* Returns:
+*  0: success
+*  1: error opening filepath
+*  3: error reading records
+*  5: error loading, records are not of whole, ascending days.
+*  6: error allocating memory
+*/
+int radiointerferometry_iers_table_load(
+  const char* filepath,
+  radiointerferometry_iers_table_t* table
+);
+
+/*
+* As `radiointerferometry_iers_table_load`, but only decodes and stores the
+* columns in `column_mask`, the rest are NULL. The year column is always
+* loaded, as it marks the days present.
+*/
+int radiointerferometry_iers_table_load_columns(
+  const char* filepath,
+  uint32_t column_mask,
+  radiointerferometry_iers_table_t* table
+);
+
+void radiointerferometry_iers_table_free(
+  radiointerferometry_iers_table_t* table
+);
+
+/*
+* The in-memory equivalent of `radiointerferometry_iers_get`, making no
+* system calls. The return argument `record` is expected to have its `mjd`
+* field populated with the date of the record to be read.
+*
+* Returns:
+*  -1: error record->mjd precedes the table.
+*  0: success
+*  4: error reading subsequent record, could not interpolate, MJD clipped to the last record.
+*  5: error the table does not have the record, or the subsequent record for interpolation.
+*/
+int radiointerferometry_iers_table_get(
+  const radiointerferometry_iers_table_t* table,
+  radiointerferometry_iers_record_t* record
+);
+
+/*
+* Remembers the pair of records bracketing the last MJD looked up, so that
+* subsequent lookups within the same day cost one subtraction and one FMA per
+* column. Only the columns in `column_mask` are maintained. The year, month,
+* day and flag columns are not interpolated, they are those of the preceding
+* record, as for `radiointerferometry_iers_table_get`. Interpolated values may
+* differ from those of `radiointerferometry_iers_table_get` in the last bit,
+* due to the FMA.
+*/
+typedef struct
+{
+  const radiointerferometry_iers_table_t* table;
+  uint32_t column_mask;
+  double mjd_lower;     // MJD of the preceding record, NaN until the first lookup
+  bool interpolable;    // whether the subsequent record exists
+  double value[RADIOINTERFEROMETRY_IERS_COLUMN_COUNT]; // of the preceding record
+  double slope[RADIOINTERFEROMETRY_IERS_COLUMN_COUNT]; // per day, to the subsequent record
+} radiointerferometry_iers_cursor_t;
+
+void radiointerferometry_iers_cursor_init(
+  radiointerferometry_iers_cursor_t* cursor,
+  const radiointerferometry_iers_table_t* table,
+  uint32_t column_mask
+);
+
+/*
+* Writes `values[column]` for each column in the cursor's `column_mask`,
+* less those not loaded in the table.
+*
+* Returns as per `radiointerferometry_iers_table_get`.
+*/
+int radiointerferometry_iers_cursor_get(
+  radiointerferometry_iers_cursor_t* cursor,
+  double mjd,
+  double values[RADIOINTERFEROMETRY_IERS_COLUMN_COUNT]
+);
+
+/*
+* Looks up `count` MJDs, writing `columns[column][i]` for each column in
+* `column_mask`, the rest of `columns` may be NULL. Lookups are made through a
+* cursor, so time-ordered MJDs are cheapest.
+*
+* Returns:
+*  Zero if success, otherwise `(index+1)*10+(errcode+1)` encoding the index of
+*  the erroneous MJD and the `radiointerferometry_iers_table_get` errcode.
+*/
+int radiointerferometry_iers_table_get_many(
+  const radiointerferometry_iers_table_t* table,
+  const double* mjd,
+  size_t count,
+  uint32_t column_mask,
+  double* columns[RADIOINTERFEROMETRY_IERS_COLUMN_COUNT]
+);
+
+/*
+* The binary cache of an IERS file is a header followed by the float64 column
+* arrays of its table, in column order, each `record_count` long. The cache is
+* native-endian, for the processes of a node to share it.
+*/
+#define RADIOINTERFEROMETRY_IERS_CACHE_MAGIC "RIC99EOP"
+#define RADIOINTERFEROMETRY_IERS_CACHE_VERSION 1
+
+typedef struct
+{
+  char magic[8];              // RADIOINTERFEROMETRY_IERS_CACHE_MAGIC
+  uint32_t version;           // RADIOINTERFEROMETRY_IERS_CACHE_VERSION
+  uint32_t column_count;      // RADIOINTERFEROMETRY_IERS_COLUMN_COUNT
+  uint64_t source_size;       // bytes of the IERS file cached
+  int64_t source_mtime_sec;   // modification time of the IERS file cached
+  int64_t source_mtime_nsec;
+  double mjd_start;
+  uint64_t record_count;
+  uint64_t _reserved;
+} radiointerferometry_iers_cache_header_t;
+
+/*
+* Writes the binary cache of the IERS file `filepath` to `cache_filepath`.
+* The cache is written aside and renamed into place, so that readers never
+* see a partial cache.
+*
+* Returns:
+*  0: success
+*  1, 3, 5, 6: as per `radiointerferometry_iers_table_load`
+*  7: error writing cache_filepath
+*/
+int radiointerferometry_iers_cache_write(
+  const char* filepath,
+  const char* cache_filepath
+);
+
+/*
+* Maps the binary cache of the IERS file `filepath` read-only into `table`,
+* which is to be released with `radiointerferometry_iers_table_free`.
+* The cache is (re)written first if it is absent, of another version, or stale
+* in that the size or modification time of `filepath` has changed.
+* A NULL `cache_filepath` is taken to be `filepath` suffixed with ".cache".
+*
+* Returns:
+*  0: success
+*  1, 3, 5, 6, 7: as per `radiointerferometry_iers_cache_write`
+*  8: error mapping cache_filepath
+*/
+int radiointerferometry_iers_table_open_cache(
+  const char* filepath,
+  const char* cache_filepath,
+  radiointerferometry_iers_table_t* table
+);
+
+/*
+* An IERS table that can be reloaded while it is in use.
+* A reload parses the file into a new table, aside from the current one, then
+* publishes it with an atomic pointer swap. Readers acquire the table current
+* at that time and keep it until they release it: the old table is only freed
+* once its readers have all released it (RCU-style). Readers never take a lock,
+* only reloads are serialised with one another.
+*/
+typedef struct
+{
+  char* filepath;
+  radiointerferometry_iers_table_t* _table;
+  unsigned _epoch;            // parity selects the reader counter
+  unsigned _readers[2];
+  pthread_mutex_t _reload_mutex;
+  int64_t _loaded_size;       // of filepath when last loaded
+  int64_t _loaded_mtime_sec;
+  int64_t _loaded_mtime_nsec;
+
+  // background watcher
+  pthread_t _watcher;
+  bool _watching;
+  double _watch_period;
+  pthread_mutex_t _watch_mutex;
+  pthread_cond_t _watch_cond;
+} radiointerferometry_iers_handle_t;
+
+/*
+* Loads filepath into the handle, which is to be released with
+* `radiointerferometry_iers_handle_free`.
+*
+* Returns as per `radiointerferometry_iers_table_load`.
+*/
+int radiointerferometry_iers_handle_init(
+  radiointerferometry_iers_handle_t* handle,
+  const char* filepath
+);
+
+/*
+* Reloads the handle's filepath, keeping the current table on error.
+* Blocks until the readers of the replaced table have released it.
+*
+* Returns as per `radiointerferometry_iers_table_load`.
+*/
+int radiointerferometry_iers_handle_reload(
+  radiointerferometry_iers_handle_t* handle
+);
+
+/*
+* Starts a background thread that checks the size and modification time of the
+* handle's filepath every `period_seconds`, reloading it when it has changed.
+* A file that fails to load (e.g. while it is being rewritten) is retried at the
+* next period.
+*
+* Returns 0 on success, otherwise the `pthread_create` error.
+*/
+int radiointerferometry_iers_handle_watch(
+  radiointerferometry_iers_handle_t* handle,
+  double period_seconds
+);
+
+/*
+* Stops any watcher and frees the handle's table. There must be no readers.
+*/
+void radiointerferometry_iers_handle_free(
+  radiointerferometry_iers_handle_t* handle
+);
+
+/*
+* Acquires the current table, which remains valid until released with the
+* same `ticket`. Lock-free: neither call ever blocks.
+*/
+const radiointerferometry_iers_table_t* radiointerferometry_iers_handle_acquire(
+  radiointerferometry_iers_handle_t* handle,
+  unsigned* ticket
+);
+
+void radiointerferometry_iers_handle_release(
+  radiointerferometry_iers_handle_t* handle,
+  unsigned ticket
+);
+
+/*
+* `radiointerferometry_iers_table_get` on the current table.
+*/
+int radiointerferometry_iers_handle_get(
+  radiointerferometry_iers_handle_t* handle,
+  radiointerferometry_iers_record_t* record
+);
+
+#endif // __RADIOINTERFEROMETRY_C99_IERS_H_
@@ -0,0 +1,188 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "radiointerferometryc99.h"
+
+size_t calc_baseline_count(int antenna_count) {
+	return (size_t)antenna_count*(antenna_count+1)/2;
+}
+
+/*
+ * The index of the first baseline of the row (BASELINE_ORDERING_UPPER_TRIANGULAR)
+ * or column (BASELINE_ORDERING_TRIANGULAR_BY_COLUMN) of antenna `a`.
+ */
+static size_t _baseline_line_start(int antenna_count, int a, enum baseline_orderings ordering) {
+	if (ordering == BASELINE_ORDERING_TRIANGULAR_BY_COLUMN) {
+		return (size_t)a*(a+1)/2;
+	}
+	return (size_t)a*antenna_count - (size_t)a*(a-1)/2;
+}
+
+void calc_baseline_antennas(
+	int antenna_count,
+	enum baseline_orderings ordering,
+	int* antenna1,
+	int* antenna2
+) {
+	size_t b = 0;
+	for (int line = 0; line < antenna_count; line++) {
+		if (ordering == BASELINE_ORDERING_TRIANGULAR_BY_COLUMN) {
+			for (int i = 0; i <= line; i++, b++) {
+				antenna1[b] = i;
+				antenna2[b] = line;
+			}
+		}
+		else {
+			for (int j = line; j < antenna_count; j++, b++) {
+				antenna1[b] = line;
+				antenna2[b] = j;
+			}
+		}
+	}
+}
+
+typedef struct {
+	const double* antenna_uvw;
+	int antenna_count;
+	enum baseline_orderings ordering;
+	int line_begin;
+	int line_end;
+	double* baseline_uvw;
+	double* baseline_lengths;
+} _baseline_chunk_t;
+
+static void* _baseline_chunk_worker(void* chunk_void) {
+	const _baseline_chunk_t* chunk = chunk_void;
+	const double* uvw = chunk->antenna_uvw;
+	const double* fixed;
+	double* out;
+	double* lengths;
+	int begin, end, fixed_sign;
+	for (int line = chunk->line_begin; line < chunk->line_end; line++) {
+		// a line fixes one antenna of its baselines, and walks the other
+		if (chunk->ordering == BASELINE_ORDERING_TRIANGULAR_BY_COLUMN) {
+			begin = 0;
+			end = line + 1;
+			fixed_sign = 1; // the fixed antenna is antenna2
+		}
+		else {
+			begin = line;
+			end = chunk->antenna_count;
+			fixed_sign = -1; // the fixed antenna is antenna1
+		}
+		fixed = uvw + 3*line;
+		out = chunk->baseline_uvw + 3*_baseline_line_start(chunk->antenna_count, line, chunk->ordering);
+		for (int a = begin; a < end; a++, out += 3) {
+			// antenna2 - antenna1
+			out[0] = fixed_sign*(fixed[0] - uvw[3*a + 0]);
+			out[1] = fixed_sign*(fixed[1] - uvw[3*a + 1]);
+			out[2] = fixed_sign*(fixed[2] - uvw[3*a + 2]);
+		}
+		if (chunk->baseline_lengths != NULL) {
+			out = chunk->baseline_uvw + 3*_baseline_line_start(chunk->antenna_count, line, chunk->ordering);
+			lengths = chunk->baseline_lengths + _baseline_line_start(chunk->antenna_count, line, chunk->ordering);
+			for (int a = 0; a < end - begin; a++) {
+				lengths[a] = sqrt(out[3*a + 0]*out[3*a + 0] + out[3*a + 1]*out[3*a + 1] + out[3*a + 2]*out[3*a + 2]);
+			}
+		}
+	}
+	return NULL;
+}
+
+void calc_baseline_uvw(
+	const double* antenna_uvw,
+	int antenna_count,
+	enum baseline_orderings ordering,
+	int thread_count,
+	double* baseline_uvw,
+	double* baseline_lengths
+) {
+	const size_t baseline_count = calc_baseline_count(antenna_count);
+	if (thread_count < 1) {
+		thread_count = 1;
+	}
+	if (thread_count > antenna_count) {
+		thread_count = antenna_count > 0 ? antenna_count : 1;
+	}
+	_baseline_chunk_t* chunks = malloc(thread_count*sizeof(_baseline_chunk_t));
+	pthread_t* threads = malloc(thread_count*sizeof(pthread_t));
+	int* started = calloc(thread_count, sizeof(int));
+	if (chunks == NULL || threads == NULL || started == NULL) {
+		// the calling thread takes all lines, as a single chunk
+		_baseline_chunk_t chunk = {
+			.antenna_uvw = antenna_uvw,
+			.antenna_count = antenna_count,
+			.ordering = ordering,
+			.line_begin = 0,
+			.line_end = antenna_count,
+			.baseline_uvw = baseline_uvw,
+			.baseline_lengths = baseline_lengths,
+		};
+		_baseline_chunk_worker(&chunk);
+		free(chunks);
+		free(threads);
+		free(started);
+		return;
+	}
+
+	// lines differ in length, so split them to balance the baselines per thread
+	int line = 0;
+	for (int t = 0; t < thread_count; t++) {
+		chunks[t] = (_baseline_chunk_t) {
+			.antenna_uvw = antenna_uvw,
+			.antenna_count = antenna_count,
+			.ordering = ordering,
+			.line_begin = line,
+			.baseline_uvw = baseline_uvw,
+			.baseline_lengths = baseline_lengths,
+		};
+		while (
+			line < antenna_count
+			&& (t == thread_count-1 || _baseline_line_start(antenna_count, line, ordering) < (baseline_count*(t+1))/thread_count)
+		) {
+			line++;
+		}
+		chunks[t].line_end = line;
+		// the calling thread takes the first chunk, and any that fail to start
+		started[t] = t > 0 && pthread_create(threads+t, NULL, _baseline_chunk_worker, chunks+t) == 0;
+	}
+	for (int t = 0; t < thread_count; t++) {
+		if (started[t]) {
+			pthread_join(threads[t], NULL);
+		}
+		else {
+			_baseline_chunk_worker(chunks+t);
+		}
+	}
+
+	free(chunks);
+	free(threads);
+	free(started);
+}
+
+/*
+ * Returns:
+ *  0: success
+ *  6: error allocating memory
+ */
+int calc_baseline_uvw_from_xyz(
+	const double* positions_xyz,
+	int antenna_count,
+	double hour_angle_rad,
+	double declination_rad,
+	double longitude_rad,
+	enum baseline_orderings ordering,
+	int thread_count,
+	double* baseline_uvw,
+	double* baseline_lengths
+) {
+	double* antenna_uvw = malloc(3*antenna_count*sizeof(double));
+	if (antenna_uvw == NULL) {
+		return 6;
+	}
+	memcpy(antenna_uvw, positions_xyz, 3*antenna_count*sizeof(double));
+	calc_position_to_uvw_frame_from_xyz(antenna_uvw, antenna_count, hour_angle_rad, declination_rad, longitude_rad);
+	calc_baseline_uvw(antenna_uvw, antenna_count, ordering, thread_count, baseline_uvw, baseline_lengths);
+	free(antenna_uvw);
+	return 0;
+}
@@ -0,0 +1,197 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "radiointerferometryc99.h"
+
+/*
+ * The Chebyshev polynomials of the first kind, and their first and second
+ * derivatives, at `x` for degrees [0, coefficient_count).
+ * T[j+1] = 2x*T[j] - T[j-1]
+ * T'[j+1] = 2T[j] + 2x*T'[j] - T'[j-1]
+ * T''[j+1] = 4T'[j] + 2x*T''[j] - T''[j-1]
+ */
+static void _chebyshev_terms(
+	double x,
+	int coefficient_count,
+	double* t,
+	double* dt,
+	double* ddt
+) {
+	t[0] = 1.0;
+	dt[0] = 0.0;
+	ddt[0] = 0.0;
+	if (coefficient_count > 1) {
+		t[1] = x;
+		dt[1] = 1.0;
+		ddt[1] = 0.0;
+	}
+	for (int j = 1; j+1 < coefficient_count; j++) {
+		t[j+1] = 2*x*t[j] - t[j-1];
+		dt[j+1] = 2*t[j] + 2*x*dt[j] - dt[j-1];
+		ddt[j+1] = 4*dt[j] + 2*x*ddt[j] - ddt[j-1];
+	}
+}
+
+/*
+ * The geometric delays of the positions at `timemjd`, via `calc_ha_dec_rad`
+ * and `calc_position_delays`. `positions_uvw` is scratch.
+ */
+static void _delay_model_geometry(
+	const double* positions_xyz,
+	double* positions_uvw,
+	int position_count,
+	int reference_position_index,
+	double ra_rad,
+	double dec_rad,
+	double longitude_rad,
+	double latitude_rad,
+	double altitude,
+	double timemjd,
+	double dut1,
+	double* delays
+) {
+	double hour_angle_rad, declination_rad;
+	calc_ha_dec_rad(
+		ra_rad, dec_rad,
+		longitude_rad, latitude_rad, altitude,
+		timemjd, dut1,
+		&hour_angle_rad, &declination_rad
+	);
+	memcpy(positions_uvw, positions_xyz, position_count*3*sizeof(double));
+	calc_position_delays(
+		positions_uvw,
+		position_count,
+		reference_position_index,
+		hour_angle_rad,
+		declination_rad,
+		longitude_rad,
+		delays
+	);
+}
+
+int calc_delay_model_fit(
+	calc_delay_model_t* model,
+	const double* positions_xyz,
+	int position_count,
+	int reference_position_index,
+	double ra_rad,
+	double dec_rad,
+	double longitude_rad,
+	double latitude_rad,
+	double altitude,
+	double timemjd_start,
+	double timemjd_end,
+	double dut1,
+	int order
+) {
+	if (order < 0 || order > CALC_DELAY_MODEL_MAX_ORDER || !(timemjd_end > timemjd_start)) {
+		return 1;
+	}
+	const int n = order + 1;
+	const double timemjd_mid = 0.5*(timemjd_start + timemjd_end);
+	const double timemjd_half = 0.5*(timemjd_end - timemjd_start);
+	double t[CALC_DELAY_MODEL_MAX_ORDER+1], dt[CALC_DELAY_MODEL_MAX_ORDER+1], ddt[CALC_DELAY_MODEL_MAX_ORDER+1];
+	double x, residual;
+
+	model->position_count = position_count;
+	model->coefficient_count = n;
+	model->timemjd_start = timemjd_start;
+	model->timemjd_end = timemjd_end;
+	model->max_residual = 0.0;
+	model->coefficients = calloc(position_count*n, sizeof(double));
+	double* positions_uvw = malloc(position_count*3*sizeof(double));
+	double* delays = malloc(position_count*sizeof(double));
+	if (model->coefficients == NULL || positions_uvw == NULL || delays == NULL) {
+		free(model->coefficients);
+		model->coefficients = NULL;
+		free(positions_uvw);
+		free(delays);
+		return 6;
+	}
+
+	// discrete Chebyshev transform of the delays at the Chebyshev nodes
+	for (int k = 0; k < n; k++) {
+		x = cos(RADIOINTERFEROMETERY_PI*(k + 0.5)/n);
+		_delay_model_geometry(
+			positions_xyz, positions_uvw, position_count, reference_position_index,
+			ra_rad, dec_rad, longitude_rad, latitude_rad, altitude,
+			timemjd_mid + timemjd_half*x, dut1,
+			delays
+		);
+		_chebyshev_terms(x, n, t, dt, ddt);
+		for (int a = 0; a < position_count; a++) {
+			for (int j = 0; j < n; j++) {
+				model->coefficients[a*n + j] += (j == 0 ? 1.0 : 2.0)/n * delays[a] * t[j];
+			}
+		}
+	}
+
+	// residuals at the extrema, which interleave the nodes and include the window edges
+	for (int k = 0; k <= n; k++) {
+		x = cos(RADIOINTERFEROMETERY_PI*k/n);
+		_delay_model_geometry(
+			positions_xyz, positions_uvw, position_count, reference_position_index,
+			ra_rad, dec_rad, longitude_rad, latitude_rad, altitude,
+			timemjd_mid + timemjd_half*x, dut1,
+			delays
+		);
+		_chebyshev_terms(x, n, t, dt, ddt);
+		for (int a = 0; a < position_count; a++) {
+			residual = delays[a];
+			for (int j = 0; j < n; j++) {
+				residual -= model->coefficients[a*n + j]*t[j];
+			}
+			if (fabs(residual) > model->max_residual) {
+				model->max_residual = fabs(residual);
+			}
+		}
+	}
+
+	free(positions_uvw);
+	free(delays);
+	return 0;
+}
+
+void calc_delay_model_evaluate(
+	const calc_delay_model_t* model,
+	double timemjd,
+	double* delays,
+	double* delay_rates,
+	double* delay_accelerations
+) {
+	const int n = model->coefficient_count;
+	const double timemjd_half = 0.5*(model->timemjd_end - model->timemjd_start);
+	// dx/dt, per second
+	const double x_rate = 1.0/(timemjd_half*RADIOINTERFEROMETERY_DAYSEC);
+	const double x = (timemjd - model->timemjd_start)/timemjd_half - 1.0;
+	double t[CALC_DELAY_MODEL_MAX_ORDER+1], dt[CALC_DELAY_MODEL_MAX_ORDER+1], ddt[CALC_DELAY_MODEL_MAX_ORDER+1];
+	double delay, rate, acceleration;
+	const double* coefficients;
+
+	_chebyshev_terms(x, n, t, dt, ddt);
+	for (int a = 0; a < model->position_count; a++) {
+		coefficients = model->coefficients + a*n;
+		delay = 0.0;
+		rate = 0.0;
+		acceleration = 0.0;
+		for (int j = 0; j < n; j++) {
+			delay += coefficients[j]*t[j];
+			rate += coefficients[j]*dt[j];
+			acceleration += coefficients[j]*ddt[j];
+		}
+		delays[a] = delay;
+		if (delay_rates != NULL) {
+			delay_rates[a] = rate*x_rate;
+		}
+		if (delay_accelerations != NULL) {
+			delay_accelerations[a] = acceleration*x_rate*x_rate;
+		}
+	}
+}
+
+void calc_delay_model_free(
+	calc_delay_model_t* model
+) {
+	free(model->coefficients);
+	model->coefficients = NULL;
+}
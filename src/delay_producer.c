@@ -0,0 +1,212 @@
+#define _POSIX_C_SOURCE 200809L
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "radiointerferometryc99.h"
+
+/*
+* The ring holds the sets `[_tail, _head)`: the producer alone advances
+* `_head`, the consumer alone advances `_tail`, each publishing with a release
+* store that the other reads with an acquire load. The consumer keeps the set
+* at `_tail` (the last it was handed) until it moves on, so the producer never
+* overwrites a set in use. The atomics are GCC/Clang builtins, as C99 has none.
+*/
+
+static void* _delay_producer_thread(void* producer_void) {
+	calc_delay_producer_t* producer = producer_void;
+	const size_t set_length = (size_t)producer->session.beam_count*producer->session.antenna_count;
+	const double idle_seconds = producer->step_seconds/4 < 1e-3 ? producer->step_seconds/4 : 1e-3;
+	const struct timespec idle = {
+		.tv_sec = 0,
+		.tv_nsec = (long) (idle_seconds*1e9),
+	};
+	unsigned long head = 0, tail;
+	long set_index = 0, consumer_index;
+	size_t slot;
+	int rv;
+
+	while (__atomic_load_n(&producer->_running, __ATOMIC_ACQUIRE)) {
+		tail = __atomic_load_n(&producer->_tail, __ATOMIC_ACQUIRE);
+		consumer_index = __atomic_load_n(&producer->_consumer_index, __ATOMIC_RELAXED);
+		// never produce sets the consumer has already passed
+		if (set_index < consumer_index) {
+			set_index = consumer_index;
+		}
+		if (head - tail >= (unsigned long) producer->depth || set_index > consumer_index + producer->lead_sets) {
+			nanosleep(&idle, NULL);
+			continue;
+		}
+
+		rv = calc_tracking_session_advance(
+			&producer->session,
+			producer->start_date1,
+			producer->start_date2 + set_index*producer->step_seconds/RADIOINTERFEROMETERY_DAYSEC
+		);
+		if (rv != 0) {
+			__atomic_store_n(&producer->_status, rv, __ATOMIC_RELAXED);
+			break;
+		}
+		slot = head % producer->depth;
+		memcpy(
+			producer->_slot_delays + slot*set_length,
+			calc_tracking_session_get_delays(&producer->session),
+			set_length*sizeof(double)
+		);
+		producer->_slot_index[slot] = set_index;
+		__atomic_store_n(&producer->_head, ++head, __ATOMIC_RELEASE);
+		__atomic_add_fetch(&producer->_produced, 1, __ATOMIC_RELAXED);
+		set_index++;
+	}
+	return NULL;
+}
+
+/*
+ * Starts a thread producing the delays of sets at the UTC dates
+ * `start_date1 + start_date2 + index*step_seconds` (index = 0, 1, ...), at most
+ * `lead_seconds` ahead of the consumer's last poll and `depth` sets deep. The
+ * session arguments are as per `calc_tracking_session_init`.
+ *
+ * Returns:
+ *  0: success
+ *  -1: error `step_seconds` is not positive, or `lead_seconds` is negative
+ *      or spans more sets than a long holds.
+ *  6: error allocating memory
+ *  otherwise the `pthread_create` error.
+ */
+int calc_delay_producer_start(
+	calc_delay_producer_t* producer,
+	const calc_site_t* site,
+	const double* positions_xyz,
+	int antenna_count,
+	int reference_antenna_index,
+	const double* ra_rad,
+	const double* dec_rad,
+	int beam_count,
+	const radiointerferometry_iers_table_t* iers_table,
+	double dut1,
+	double astrom_window_seconds,
+	double start_date1,
+	double start_date2,
+	double step_seconds,
+	double lead_seconds,
+	int depth
+) {
+	memset(producer, 0, sizeof(calc_delay_producer_t));
+	// negated so that NaNs are rejected too
+	if (!(step_seconds > 0) || !(lead_seconds >= 0) || !(lead_seconds/step_seconds < LONG_MAX)) {
+		return -1;
+	}
+	int rv = calc_tracking_session_init(
+		&producer->session,
+		site,
+		positions_xyz,
+		antenna_count,
+		reference_antenna_index,
+		ra_rad,
+		dec_rad,
+		beam_count,
+		iers_table,
+		dut1,
+		astrom_window_seconds
+	);
+	if (rv != 0) {
+		return rv;
+	}
+	producer->start_date1 = start_date1;
+	producer->start_date2 = start_date2;
+	producer->step_seconds = step_seconds;
+	producer->lead_sets = (long) ceil(lead_seconds/step_seconds);
+	producer->depth = depth < 2 ? 2 : depth;
+	producer->_slot_delays = malloc((size_t)producer->depth*beam_count*antenna_count*sizeof(double));
+	producer->_slot_index = malloc(producer->depth*sizeof(long));
+	if (producer->_slot_delays == NULL || producer->_slot_index == NULL) {
+		calc_delay_producer_stop(producer);
+		return 6;
+	}
+
+	producer->_running = true;
+	rv = pthread_create(&producer->_thread, NULL, _delay_producer_thread, producer);
+	if (rv != 0) {
+		producer->_running = false;
+		calc_delay_producer_stop(producer);
+	}
+	return rv;
+}
+
+/*
+ * Stops the thread and frees the producer.
+ */
+void calc_delay_producer_stop(
+	calc_delay_producer_t* producer
+) {
+	if (__atomic_exchange_n(&producer->_running, false, __ATOMIC_ACQ_REL)) {
+		pthread_join(producer->_thread, NULL);
+	}
+	calc_tracking_session_free(&producer->session);
+	free(producer->_slot_delays);
+	free(producer->_slot_index);
+	producer->_slot_delays = NULL;
+	producer->_slot_index = NULL;
+}
+
+/*
+ * Hands the consumer the delays of the set at or before the UTC date
+ * `date1 + date2` (as for ERFA), in `delays[beam*antenna_count + antenna]`,
+ * valid until the next poll. Never blocks: the sets before it are released to
+ * the producer, and if the set is not (yet) produced that is an underrun.
+ *
+ * Returns:
+ *  0: success
+ *  1: underrun, `delays` is untouched
+ *  2: the date precedes the first set
+ */
+int calc_delay_producer_poll(
+	calc_delay_producer_t* producer,
+	double date1,
+	double date2,
+	const double** delays
+) {
+	const size_t set_length = (size_t)producer->session.beam_count*producer->session.antenna_count;
+	const double offset_seconds = ((date1 - producer->start_date1) + (date2 - producer->start_date2))*RADIOINTERFEROMETERY_DAYSEC;
+	const long set_index = (long) floor(offset_seconds/producer->step_seconds);
+	if (set_index < 0) {
+		return 2;
+	}
+	__atomic_store_n(&producer->_consumer_index, set_index, __ATOMIC_RELAXED);
+
+	const unsigned long head = __atomic_load_n(&producer->_head, __ATOMIC_ACQUIRE);
+	unsigned long tail = producer->_tail;
+	while (tail + 1 < head && producer->_slot_index[(tail + 1) % producer->depth] <= set_index) {
+		tail++;
+	}
+	if (tail < head && producer->_slot_index[tail % producer->depth] == set_index) {
+		__atomic_store_n(&producer->_tail, tail, __ATOMIC_RELEASE);
+		*delays = producer->_slot_delays + (tail % producer->depth)*set_length;
+		return 0;
+	}
+	if (tail < head && producer->_slot_index[tail % producer->depth] < set_index) {
+		// stale, release it too
+		tail++;
+	}
+	__atomic_store_n(&producer->_tail, tail, __ATOMIC_RELEASE);
+	__atomic_add_fetch(&producer->_underruns, 1, __ATOMIC_RELAXED);
+	return 1;
+}
+
+/*
+ * The number of sets produced and of polls that underran, and the producer's
+ * `calc_tracking_session_advance` error, 0 if none (it stops producing on
+ * error).
+ */
+void calc_delay_producer_counters(
+	calc_delay_producer_t* producer,
+	unsigned long* produced,
+	unsigned long* underruns,
+	int* status
+) {
+	*produced = __atomic_load_n(&producer->_produced, __ATOMIC_RELAXED);
+	*underruns = __atomic_load_n(&producer->_underruns, __ATOMIC_RELAXED);
+	*status = __atomic_load_n(&producer->_status, __ATOMIC_RELAXED);
+}
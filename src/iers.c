@@ -1,219 +1,286 @@
-#include <radiointerferometryc99/iers.h>
-
-int _iers_record_parse(
-  char* char_record,
-  radiointerferometry_iers_record_t* record
-) {
-  char* char_record_end;
-  
-  char_record_end = char_record+2;
-  record->year = strtol(
-    char_record+1-1,
-    &char_record_end,
-    10
-  );
-  
-  char_record_end = char_record+4;
-  record->month = strtol(
-    char_record+3-1,
-    &char_record_end,
-    10
-  );
-  
-  char_record_end = char_record+6;
-  record->day = strtol(
-    char_record+5-1,
-    &char_record_end,
-    10
-  );
-
-  char_record_end = char_record+15;
-  record->mjd = strtod(
-    char_record+8-1,
-    &char_record_end
-  );
-  record->year += record->mjd < 51544.0 ? 1900 : 2000;
-
-  record->polpmflag_a = char_record[17-1] != 'I';
+#define _POSIX_C_SOURCE 200809L
+#include <math.h>
+#include <string.h>
+#include <sys/mman.h>
 
-  char_record_end = char_record+27;
-  record->pm_x_a = strtod(
-    char_record+19-1,
-    &char_record_end
-  );
-
-  char_record_end = char_record+36;
-  record->e_pm_x_a = strtod(
-    char_record+28-1,
-    &char_record_end
-  );
-
-  char_record_end = char_record+46;
-  record->pm_y_a = strtod(
-    char_record+38-1,
-    &char_record_end
-  );
+#include <radiointerferometryc99/iers.h>
 
-  char_record_end = char_record+55;
-  record->e_pm_y_a = strtod(
-    char_record+47-1,
-    &char_record_end
-  );
-  record->ut1flag_a = char_record[58-1] != 'I';
+/*
+* Byte offsets (zero-based) and widths of the fixed-format fields, as
+* documented atop `radiointerferometryc99/iers.h`.
+*/
+typedef struct {
+  int offset;
+  int width;
+} _iers_field_t;
 
-  char_record_end = char_record+68;
-  record->ut1_utc_a = strtod(
-    char_record+59-1,
-    &char_record_end
-  );
+static const _iers_field_t _iers_mjd_field = {7, 8};
 
-  char_record_end = char_record+78;
-  record->e_ut1_utc_a = strtod(
-    char_record+69-1,
-    &char_record_end
-  );
+static const _iers_field_t _iers_fields[RADIOINTERFEROMETRY_IERS_COLUMN_COUNT] = {
+  [RADIOINTERFEROMETRY_IERS_COLUMN_YEAR]         = {  0,  2},
+  [RADIOINTERFEROMETRY_IERS_COLUMN_MONTH]        = {  2,  2},
+  [RADIOINTERFEROMETRY_IERS_COLUMN_DAY]          = {  4,  2},
+  [RADIOINTERFEROMETRY_IERS_COLUMN_POLPMFLAG_A]  = { 16,  1},
+  [RADIOINTERFEROMETRY_IERS_COLUMN_PM_X_A]       = { 18,  9},
+  [RADIOINTERFEROMETRY_IERS_COLUMN_E_PM_X_A]     = { 27,  9},
+  [RADIOINTERFEROMETRY_IERS_COLUMN_PM_Y_A]       = { 37,  9},
+  [RADIOINTERFEROMETRY_IERS_COLUMN_E_PM_Y_A]     = { 46,  9},
+  [RADIOINTERFEROMETRY_IERS_COLUMN_UT1FLAG_A]    = { 57,  1},
+  [RADIOINTERFEROMETRY_IERS_COLUMN_UT1_UTC_A]    = { 58, 10},
+  [RADIOINTERFEROMETRY_IERS_COLUMN_E_UT1_UTC_A]  = { 68, 10},
+  [RADIOINTERFEROMETRY_IERS_COLUMN_LOD_A]        = { 79,  7},
+  [RADIOINTERFEROMETRY_IERS_COLUMN_E_LOD_A]      = { 86,  7},
+  [RADIOINTERFEROMETRY_IERS_COLUMN_NUTFLAG_A]    = { 95,  1},
+  [RADIOINTERFEROMETRY_IERS_COLUMN_DX_2000A_A]   = { 97,  9},
+  [RADIOINTERFEROMETRY_IERS_COLUMN_E_DX_2000A_A] = {106,  9},
+  [RADIOINTERFEROMETRY_IERS_COLUMN_DY_2000A_A]   = {116,  9},
+  [RADIOINTERFEROMETRY_IERS_COLUMN_E_DY_2000A_A] = {125,  9},
+  [RADIOINTERFEROMETRY_IERS_COLUMN_PM_X_B]       = {134, 10},
+  [RADIOINTERFEROMETRY_IERS_COLUMN_PM_Y_B]       = {144, 10},
+  [RADIOINTERFEROMETRY_IERS_COLUMN_UT1_UTC_B]    = {154, 11},
+  [RADIOINTERFEROMETRY_IERS_COLUMN_DX_2000A_B]   = {165, 10},
+  [RADIOINTERFEROMETRY_IERS_COLUMN_DY_2000A_B]   = {175, 10},
+};
 
-  char_record_end = char_record+86;
-  record->lod_a = strtod(
-    char_record+80-1,
-    &char_record_end
-  );
+static const double _iers_pow10[] = {
+  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11
+};
 
-  char_record_end = char_record+93;
-  record->e_lod_a = strtod(
-    char_record+87-1,
-    &char_record_end
-  );
-  record->nutflag_a = char_record[96-1] != 'I';
+/*
+* Decodes an `In` or `Fn.d` field of `width` bytes, blank if empty.
+* The digits are accumulated as an exact integer and divided by an exact power
+* of ten, so the result is the correctly rounded value, as `strtod` produces.
+*/
+static inline double _iers_field_decode(
+  const char* field,
+  int width
+) {
+  const char* field_end = field + width;
+  while (field < field_end && *field == ' ') {
+    field++;
+  }
+  bool negative = false;
+  if (field < field_end && (*field == '-' || *field == '+')) {
+    negative = *field == '-';
+    field++;
+  }
 
-  char_record_end = char_record+106;
-  record->dx_2000a_a = strtod(
-    char_record+98-1,
-    &char_record_end
-  );
+  int64_t mantissa = 0;
+  int decimals = -1;
+  for (; field < field_end; field++) {
+    if (*field >= '0' && *field <= '9') {
+      mantissa = mantissa*10 + (*field - '0');
+      decimals += decimals >= 0;
+    }
+    else if (*field == '.' && decimals < 0) {
+      decimals = 0;
+    }
+    else {
+      break;
+    }
+  }
 
-  char_record_end = char_record+115;
-  record->e_dx_2000a_a = strtod(
-    char_record+107-1,
-    &char_record_end
-  );
+  double value = decimals > 0 ? mantissa / _iers_pow10[decimals] : (double) mantissa;
+  return negative ? -value : value;
+}
 
-  char_record_end = char_record+125;
-  record->dy_2000a_a = strtod(
-    char_record+117-1,
-    &char_record_end
-  );
+static inline double _iers_record_decode_mjd(
+  const char* char_record
+) {
+  return _iers_field_decode(char_record + _iers_mjd_field.offset, _iers_mjd_field.width);
+}
 
-  char_record_end = char_record+134;
-  record->e_dy_2000a_a = strtod(
-    char_record+126-1,
-    &char_record_end
-  );
+/*
+* Decodes the fields of `column_mask` into `values`, indexed by column.
+* Flags are decoded as 0.0 (IERS) or 1.0 (Prediction).
+*/
+double _iers_record_decode(
+  const char* char_record,
+  uint32_t column_mask,
+  double values[RADIOINTERFEROMETRY_IERS_COLUMN_COUNT]
+) {
+  double mjd = _iers_record_decode_mjd(char_record);
+  for (int column = 0; column < RADIOINTERFEROMETRY_IERS_COLUMN_COUNT; column++) {
+    if (!(column_mask & RADIOINTERFEROMETRY_IERS_COLUMN_MASK(column))) {
+      continue;
+    }
+    switch (column) {
+      case RADIOINTERFEROMETRY_IERS_COLUMN_POLPMFLAG_A:
+      case RADIOINTERFEROMETRY_IERS_COLUMN_UT1FLAG_A:
+      case RADIOINTERFEROMETRY_IERS_COLUMN_NUTFLAG_A:
+        values[column] = char_record[_iers_fields[column].offset] != 'I';
+        break;
+      case RADIOINTERFEROMETRY_IERS_COLUMN_YEAR:
+        values[column] = _iers_field_decode(char_record, 2) + (mjd < 51544.0 ? 1900 : 2000);
+        break;
+      default:
+        values[column] = _iers_field_decode(
+          char_record + _iers_fields[column].offset,
+          _iers_fields[column].width
+        );
+    }
+  }
+  return mjd;
+}
 
-  char_record_end = char_record+144;
-  record->pm_x_b = strtod(
-    char_record+135-1,
-    &char_record_end
-  );
+void _iers_record_set_values(
+  radiointerferometry_iers_record_t* record,
+  double mjd,
+  const double values[RADIOINTERFEROMETRY_IERS_COLUMN_COUNT],
+  uint32_t column_mask
+) {
+  record->mjd = mjd;
+  #define _IERS_SET(column, field) \
+    if (column_mask & RADIOINTERFEROMETRY_IERS_COLUMN_MASK(column)) { \
+      record->field = values[column]; \
+    }
+  _IERS_SET(RADIOINTERFEROMETRY_IERS_COLUMN_YEAR,         year);
+  _IERS_SET(RADIOINTERFEROMETRY_IERS_COLUMN_MONTH,        month);
+  _IERS_SET(RADIOINTERFEROMETRY_IERS_COLUMN_DAY,          day);
+  _IERS_SET(RADIOINTERFEROMETRY_IERS_COLUMN_POLPMFLAG_A,  polpmflag_a);
+  _IERS_SET(RADIOINTERFEROMETRY_IERS_COLUMN_PM_X_A,       pm_x_a);
+  _IERS_SET(RADIOINTERFEROMETRY_IERS_COLUMN_E_PM_X_A,     e_pm_x_a);
+  _IERS_SET(RADIOINTERFEROMETRY_IERS_COLUMN_PM_Y_A,       pm_y_a);
+  _IERS_SET(RADIOINTERFEROMETRY_IERS_COLUMN_E_PM_Y_A,     e_pm_y_a);
+  _IERS_SET(RADIOINTERFEROMETRY_IERS_COLUMN_UT1FLAG_A,    ut1flag_a);
+  _IERS_SET(RADIOINTERFEROMETRY_IERS_COLUMN_UT1_UTC_A,    ut1_utc_a);
+  _IERS_SET(RADIOINTERFEROMETRY_IERS_COLUMN_E_UT1_UTC_A,  e_ut1_utc_a);
+  _IERS_SET(RADIOINTERFEROMETRY_IERS_COLUMN_LOD_A,        lod_a);
+  _IERS_SET(RADIOINTERFEROMETRY_IERS_COLUMN_E_LOD_A,      e_lod_a);
+  _IERS_SET(RADIOINTERFEROMETRY_IERS_COLUMN_NUTFLAG_A,    nutflag_a);
+  _IERS_SET(RADIOINTERFEROMETRY_IERS_COLUMN_DX_2000A_A,   dx_2000a_a);
+  _IERS_SET(RADIOINTERFEROMETRY_IERS_COLUMN_E_DX_2000A_A, e_dx_2000a_a);
+  _IERS_SET(RADIOINTERFEROMETRY_IERS_COLUMN_DY_2000A_A,   dy_2000a_a);
+  _IERS_SET(RADIOINTERFEROMETRY_IERS_COLUMN_E_DY_2000A_A, e_dy_2000a_a);
+  _IERS_SET(RADIOINTERFEROMETRY_IERS_COLUMN_PM_X_B,       pm_x_b);
+  _IERS_SET(RADIOINTERFEROMETRY_IERS_COLUMN_PM_Y_B,       pm_y_b);
+  _IERS_SET(RADIOINTERFEROMETRY_IERS_COLUMN_UT1_UTC_B,    ut1_utc_b);
+  _IERS_SET(RADIOINTERFEROMETRY_IERS_COLUMN_DX_2000A_B,   dx_2000a_b);
+  _IERS_SET(RADIOINTERFEROMETRY_IERS_COLUMN_DY_2000A_B,   dy_2000a_b);
+  #undef _IERS_SET
+}
 
-  char_record_end = char_record+154;
-  record->pm_y_b = strtod(
-    char_record+145-1,
-    &char_record_end
-  );
+int _iers_record_parse(
+  const char* char_record,
+  radiointerferometry_iers_record_t* record
+) {
+  double values[RADIOINTERFEROMETRY_IERS_COLUMN_COUNT];
+  double mjd = _iers_record_decode(char_record, RADIOINTERFEROMETRY_IERS_COLUMN_MASK_ALL, values);
+  _iers_record_set_values(record, mjd, values, RADIOINTERFEROMETRY_IERS_COLUMN_MASK_ALL);
+  return 0;
+}
 
-  char_record_end = char_record+165;
-  record->ut1_utc_b = strtod(
-    char_record+155-1,
-    &char_record_end
-  );
+void _iers_record_interpolate(
+  radiointerferometry_iers_record_t* record,
+  const radiointerferometry_iers_record_t* next_record,
+  double fraction
+) {
+  record->pm_x_a        += fraction*(next_record->pm_x_a       - record->pm_x_a);
+  record->e_pm_x_a      += fraction*(next_record->e_pm_x_a     - record->e_pm_x_a);
+  record->pm_y_a        += fraction*(next_record->pm_y_a       - record->pm_y_a);
+  record->e_pm_y_a      += fraction*(next_record->e_pm_y_a     - record->e_pm_y_a);
+  record->ut1_utc_a     += fraction*(next_record->ut1_utc_a    - record->ut1_utc_a);
+  record->e_ut1_utc_a   += fraction*(next_record->e_ut1_utc_a  - record->e_ut1_utc_a);
+  record->lod_a         += fraction*(next_record->lod_a        - record->lod_a);
+  record->e_lod_a       += fraction*(next_record->e_lod_a      - record->e_lod_a);
+  record->dx_2000a_a    += fraction*(next_record->dx_2000a_a   - record->dx_2000a_a);
+  record->e_dx_2000a_a  += fraction*(next_record->e_dx_2000a_a - record->e_dx_2000a_a);
+  record->dy_2000a_a    += fraction*(next_record->dy_2000a_a   - record->dy_2000a_a);
+  record->e_dy_2000a_a  += fraction*(next_record->e_dy_2000a_a - record->e_dy_2000a_a);
+  record->pm_x_b        += fraction*(next_record->pm_x_b       - record->pm_x_b);
+  record->pm_y_b        += fraction*(next_record->pm_y_b       - record->pm_y_b);
+  record->ut1_utc_b     += fraction*(next_record->ut1_utc_b    - record->ut1_utc_b);
+  record->dx_2000a_b    += fraction*(next_record->dx_2000a_b   - record->dx_2000a_b);
+  record->dy_2000a_b    += fraction*(next_record->dy_2000a_b   - record->dy_2000a_b);
+  record->mjd += fraction;
+}
 
-  char_record_end = char_record+175;
-  record->dx_2000a_b = strtod(
-    char_record+166-1,
-    &char_record_end
-  );
+/*
+* Returns the stride of the records, being the record length plus that of its
+* line terminator, or 0 if `char_records` does not start with a record.
+*/
+static size_t _iers_record_stride(
+  const char* char_records,
+  size_t size
+) {
+  const char* newline = memchr(char_records, '\n', size < 187+2 ? size : 187+2);
+  size_t stride = newline == NULL ? size : (size_t)(newline - char_records) + 1;
+  if (stride < 187 || stride > 187+2) {
+    return 0;
+  }
+  return stride;
+}
 
-  char_record_end = char_record+185;
-  record->dy_2000a_b = strtod(
-    char_record+176-1,
-    &char_record_end
-  );
-  return 0;
+static inline size_t _iers_record_count(
+  off_t file_size,
+  size_t stride
+) {
+  // the last record need not be terminated
+  return (file_size + (stride-187)) / stride;
 }
 
 int radiointerferometry_iers_get(
   const char* filepath,
   radiointerferometry_iers_record_t* record
 ) {
-  if (record->mjd < 41684.0) {
-    return -1;
-  }
-
   int fd = open(filepath, O_RDONLY);
   if(fd < 0) {
     return 1;
   }
 
   off_t file_size = lseek(fd, 0, SEEK_END);
-  int record_index = record->mjd - 41684.0;
-
-  // seek as close to record as naively can
-  if ((record_index+2)*188 > file_size) {
-    lseek(fd, ((file_size/188)-1)*188, SEEK_SET);
-  }
-  else {
-    lseek(fd, record_index*188, SEEK_SET);
+  char char_record[2*(187+2)] = {0};
+  ssize_t bytes_read = pread(fd, char_record, 187+2, 0);
+  size_t stride = _iers_record_stride(char_record, bytes_read > 0 ? bytes_read : 0);
+  if (stride == 0) {
+    close(fd);
+    return 3;
   }
+  size_t record_count = _iers_record_count(file_size, stride);
 
-  // search for record
   double mjd = record->mjd;
-  char char_record[187+2+188] = {0};
-  char* char_record_mjd_end = char_record+15;
-  read(
-    fd,
-    char_record,
-    15
-  );
-  record->mjd = strtod(
-    char_record+8-1,
-    &char_record_mjd_end
-  );
-  int search_direction = record->mjd == mjd ? 0 : (record->mjd < mjd ? 1 : -1);
+  if (mjd < _iers_record_decode_mjd(char_record)) {
+    close(fd);
+    return -1;
+  }
 
-  // search in one direction
-  while (search_direction != 0) {
-    if (search_direction == -1) {
-      if (record->mjd <= mjd) {
-        break;
-      }
-      lseek(fd, -15-188, SEEK_CUR);
-    }
-    else {
-      if (record->mjd >= mjd) {
-        break;
-      }
-      lseek(fd, (188-15), SEEK_CUR);
+  // bisect for the last record not after mjd, which the first record is not.
+  // Records are daily, so the first probe is the record at mjd if there are
+  // no gaps, and the second probe its neighbour, otherwise probes bisect.
+  size_t lower = 0;
+  size_t upper = record_count;
+  size_t probe = mjd - _iers_record_decode_mjd(char_record);
+  if (probe >= record_count) {
+    probe = record_count-1;
+  }
+  size_t probe_count = 0;
+  while (upper - lower > 1) {
+    if (probe <= lower || probe >= upper) {
+      probe = lower + (upper - lower)/2;
     }
-    
-    if (15 > read(fd, char_record, 15)) {
+    if (15 > pread(fd, char_record, 15, probe*stride)) {
       close(fd);
       return 2;
     }
-    record->mjd = strtod(
-      char_record+8-1,
-      &char_record_mjd_end
-    );
+    if (_iers_record_decode_mjd(char_record) <= mjd) {
+      lower = probe;
+      probe = probe_count++ == 0 ? probe+1 : 0;
+    }
+    else {
+      upper = probe;
+      probe = probe_count++ == 0 ? probe-1 : 0;
+    }
   }
 
-  // read the rest of the record and the following (for interpolation)
-  int bytes_read = read(
+  // read the record and the following (for interpolation)
+  bytes_read = pread(
     fd,
-    char_record+15,
-    (188*2)-15
+    char_record,
+    2*stride,
+    lower*stride
   );
   close(fd);
-  if (188 > bytes_read) {
+  if (187 > bytes_read) {
     return 3;
   }
 
@@ -225,15 +292,15 @@ int radiointerferometry_iers_get(
     // no need to interpolate
     return 0;
   }
-  if ((2*188)-15 > bytes_read) {
-    // could not read the subsequent record,
+  if ((ssize_t)(stride+187) > bytes_read) {
+    // there is no subsequent record,
     // cannot interperolate
     return 4;
   }
   
   radiointerferometry_iers_record_t next_record;
   _iers_record_parse(
-    char_record+188,
+    char_record+stride,
     &next_record
   );
 
@@ -242,25 +309,335 @@ int radiointerferometry_iers_get(
   }
 
   // linearly interpolate between records
-  double fraction = mjd - record->mjd;
-  record->pm_x_a        += fraction*(next_record.pm_x_a       - record->pm_x_a);
-  record->e_pm_x_a      += fraction*(next_record.e_pm_x_a     - record->e_pm_x_a);
-  record->pm_y_a        += fraction*(next_record.pm_y_a       - record->pm_y_a);
-  record->e_pm_y_a      += fraction*(next_record.e_pm_y_a     - record->e_pm_y_a);
-  record->ut1_utc_a     += fraction*(next_record.ut1_utc_a    - record->ut1_utc_a);
-  record->e_ut1_utc_a   += fraction*(next_record.e_ut1_utc_a  - record->e_ut1_utc_a);
-  record->lod_a         += fraction*(next_record.lod_a        - record->lod_a);
-  record->e_lod_a       += fraction*(next_record.e_lod_a      - record->e_lod_a);
-  record->dx_2000a_a    += fraction*(next_record.dx_2000a_a   - record->dx_2000a_a);
-  record->e_dx_2000a_a  += fraction*(next_record.e_dx_2000a_a - record->e_dx_2000a_a);
-  record->dy_2000a_a    += fraction*(next_record.dy_2000a_a   - record->dy_2000a_a);
-  record->e_dy_2000a_a  += fraction*(next_record.e_dy_2000a_a - record->e_dy_2000a_a);
-  record->pm_x_b        += fraction*(next_record.pm_x_b       - record->pm_x_b);
-  record->pm_y_b        += fraction*(next_record.pm_y_b       - record->pm_y_b);
-  record->ut1_utc_b     += fraction*(next_record.ut1_utc_b    - record->ut1_utc_b);
-  record->dx_2000a_b    += fraction*(next_record.dx_2000a_b   - record->dx_2000a_b);
-  record->dy_2000a_b    += fraction*(next_record.dy_2000a_b   - record->dy_2000a_b);
-  record->mjd += fraction;
+  _iers_record_interpolate(
+    record,
+    &next_record,
+    mjd - record->mjd
+  );
+
+  return 0;
+}
+
+void _iers_table_get_record(
+  const radiointerferometry_iers_table_t* table,
+  size_t index,
+  radiointerferometry_iers_record_t* record
+) {
+  double values[RADIOINTERFEROMETRY_IERS_COLUMN_COUNT];
+  uint32_t column_mask = 0;
+  for (int column = 0; column < RADIOINTERFEROMETRY_IERS_COLUMN_COUNT; column++) {
+    if (table->columns[column] != NULL) {
+      values[column] = table->columns[column][index];
+      column_mask |= RADIOINTERFEROMETRY_IERS_COLUMN_MASK(column);
+    }
+  }
+  _iers_record_set_values(record, table->mjd_start + index, values, column_mask);
+}
+
+int radiointerferometry_iers_table_load(
+  const char* filepath,
+  radiointerferometry_iers_table_t* table
+) {
+  return radiointerferometry_iers_table_load_columns(
+    filepath,
+    RADIOINTERFEROMETRY_IERS_COLUMN_MASK_ALL,
+    table
+  );
+}
+
+int radiointerferometry_iers_table_load_columns(
+  const char* filepath,
+  uint32_t column_mask,
+  radiointerferometry_iers_table_t* table
+) {
+  // the year column marks the days present
+  column_mask = (column_mask | RADIOINTERFEROMETRY_IERS_COLUMN_MASK(RADIOINTERFEROMETRY_IERS_COLUMN_YEAR))
+    & RADIOINTERFEROMETRY_IERS_COLUMN_MASK_ALL;
+  int column_count = 0;
+  for (int column = 0; column < RADIOINTERFEROMETRY_IERS_COLUMN_COUNT; column++) {
+    column_count += (column_mask & RADIOINTERFEROMETRY_IERS_COLUMN_MASK(column)) != 0;
+  }
+
+  int fd = open(filepath, O_RDONLY);
+  if(fd < 0) {
+    return 1;
+  }
+
+  off_t file_size = lseek(fd, 0, SEEK_END);
+  lseek(fd, 0, SEEK_SET);
+  if (file_size <= 0) {
+    close(fd);
+    return 3;
+  }
+  char* char_records = malloc(file_size+1);
+  if (char_records == NULL) {
+    close(fd);
+    return 6;
+  }
+
+  off_t bytes_read = 0;
+  ssize_t read_rv;
+  while (bytes_read < file_size) {
+    read_rv = read(fd, char_records+bytes_read, file_size-bytes_read);
+    if (read_rv <= 0) {
+      break;
+    }
+    bytes_read += read_rv;
+  }
+  close(fd);
+  if (bytes_read < file_size) {
+    free(char_records);
+    return 3;
+  }
+  char_records[file_size] = '\0';
+
+  size_t stride = _iers_record_stride(char_records, file_size);
+  if (stride == 0) {
+    free(char_records);
+    return 3;
+  }
+  size_t line_count = _iers_record_count(file_size, stride);
+  double mjd_end = _iers_record_decode_mjd(char_records + (line_count-1)*stride);
+  double mjd = _iers_record_decode_mjd(char_records);
+  if (mjd_end < mjd) {
+    free(char_records);
+    return 5;
+  }
+
+  // span the first to the last record, so that records are indexed by MJD
+  table->mjd_start = mjd;
+  table->record_count = (size_t)(mjd_end - table->mjd_start) + 1;
+  table->_storage_mapping_size = 0;
+  table->_storage = malloc(column_count*table->record_count*sizeof(double));
+  if (table->_storage == NULL) {
+    free(char_records);
+    return 6;
+  }
+  double* column_storage = table->_storage;
+  for (int column = 0; column < RADIOINTERFEROMETRY_IERS_COLUMN_COUNT; column++) {
+    if (column_mask & RADIOINTERFEROMETRY_IERS_COLUMN_MASK(column)) {
+      table->columns[column] = column_storage;
+      column_storage += table->record_count;
+    }
+    else {
+      table->columns[column] = NULL;
+    }
+  }
+  // days absent from the file remain NaN
+  for (size_t i = 0; i < column_count*table->record_count; i++) {
+    ((double*)table->_storage)[i] = NAN;
+  }
+
+  double values[RADIOINTERFEROMETRY_IERS_COLUMN_COUNT];
+  double previous_mjd = table->mjd_start - 1.0;
+  size_t record_index;
+  for (size_t i = 0; i < line_count; i++) {
+    mjd = _iers_record_decode(
+      char_records + i*stride,
+      column_mask,
+      values
+    );
+    if (mjd <= previous_mjd || mjd > mjd_end || mjd != (size_t)mjd) {
+      free(char_records);
+      radiointerferometry_iers_table_free(table);
+      return 5;
+    }
+    previous_mjd = mjd;
+    record_index = mjd - table->mjd_start;
+    for (int column = 0; column < RADIOINTERFEROMETRY_IERS_COLUMN_COUNT; column++) {
+      if (column_mask & RADIOINTERFEROMETRY_IERS_COLUMN_MASK(column)) {
+        table->columns[column][record_index] = values[column];
+      }
+    }
+  }
+
+  free(char_records);
+  return 0;
+}
+
+void radiointerferometry_iers_table_free(
+  radiointerferometry_iers_table_t* table
+) {
+  if (table->_storage_mapping_size > 0) {
+    munmap(table->_storage, table->_storage_mapping_size);
+  }
+  else {
+    free(table->_storage);
+  }
+  table->_storage = NULL;
+  table->_storage_mapping_size = 0;
+  for (int column = 0; column < RADIOINTERFEROMETRY_IERS_COLUMN_COUNT; column++) {
+    table->columns[column] = NULL;
+  }
+  table->record_count = 0;
+}
+
+int radiointerferometry_iers_table_get(
+  const radiointerferometry_iers_table_t* table,
+  radiointerferometry_iers_record_t* record
+) {
+  if (record->mjd < table->mjd_start) {
+    return -1;
+  }
+
+  double mjd = record->mjd;
+  size_t record_index = mjd - table->mjd_start;
+  if (record_index >= table->record_count) {
+    // clipped to the last record
+    record_index = table->record_count-1;
+  }
+
+  if (isnan(table->columns[RADIOINTERFEROMETRY_IERS_COLUMN_YEAR][record_index])) {
+    // the table does not have the record
+    return 5;
+  }
+  _iers_table_get_record(table, record_index, record);
+  if (record->mjd == mjd) {
+    // no need to interpolate
+    return 0;
+  }
+  if (record_index+1 >= table->record_count) {
+    // there is no subsequent record,
+    // cannot interperolate
+    return 4;
+  }
+  if (isnan(table->columns[RADIOINTERFEROMETRY_IERS_COLUMN_YEAR][record_index+1])) {
+    // the table does not have the next record,
+    // cannot interperolate
+    return 5;
+  }
+
+  // columns not loaded are left as they are
+  radiointerferometry_iers_record_t next_record = *record;
+  _iers_table_get_record(table, record_index+1, &next_record);
+
+  // linearly interpolate between records
+  _iers_record_interpolate(
+    record,
+    &next_record,
+    mjd - record->mjd
+  );
+
+  return 0;
+}
+
+static inline bool _iers_column_is_interpolated(int column) {
+  switch (column) {
+    case RADIOINTERFEROMETRY_IERS_COLUMN_YEAR:
+    case RADIOINTERFEROMETRY_IERS_COLUMN_MONTH:
+    case RADIOINTERFEROMETRY_IERS_COLUMN_DAY:
+    case RADIOINTERFEROMETRY_IERS_COLUMN_POLPMFLAG_A:
+    case RADIOINTERFEROMETRY_IERS_COLUMN_UT1FLAG_A:
+    case RADIOINTERFEROMETRY_IERS_COLUMN_NUTFLAG_A:
+      return false;
+    default:
+      return true;
+  }
+}
+
+void radiointerferometry_iers_cursor_init(
+  radiointerferometry_iers_cursor_t* cursor,
+  const radiointerferometry_iers_table_t* table,
+  uint32_t column_mask
+) {
+  cursor->table = table;
+  cursor->column_mask = 0;
+  for (int column = 0; column < RADIOINTERFEROMETRY_IERS_COLUMN_COUNT; column++) {
+    if (table->columns[column] != NULL) {
+      cursor->column_mask |= column_mask & RADIOINTERFEROMETRY_IERS_COLUMN_MASK(column);
+    }
+  }
+  cursor->mjd_lower = NAN;
+  cursor->interpolable = false;
+}
+
+int _iers_cursor_bracket(
+  radiointerferometry_iers_cursor_t* cursor,
+  double mjd
+) {
+  const radiointerferometry_iers_table_t* table = cursor->table;
+  cursor->mjd_lower = NAN;
+  if (mjd < table->mjd_start) {
+    return -1;
+  }
+  size_t record_index = mjd - table->mjd_start;
+  if (record_index >= table->record_count) {
+    // clipped to the last record
+    record_index = table->record_count-1;
+  }
+  if (isnan(table->columns[RADIOINTERFEROMETRY_IERS_COLUMN_YEAR][record_index])) {
+    return 5;
+  }
+
+  cursor->interpolable = record_index+1 < table->record_count
+    && !isnan(table->columns[RADIOINTERFEROMETRY_IERS_COLUMN_YEAR][record_index+1]);
+  for (int column = 0; column < RADIOINTERFEROMETRY_IERS_COLUMN_COUNT; column++) {
+    if (!(cursor->column_mask & RADIOINTERFEROMETRY_IERS_COLUMN_MASK(column))) {
+      continue;
+    }
+    cursor->value[column] = table->columns[column][record_index];
+    cursor->slope[column] = cursor->interpolable && _iers_column_is_interpolated(column)
+      ? table->columns[column][record_index+1] - cursor->value[column]
+      : 0.0;
+  }
+  cursor->mjd_lower = table->mjd_start + record_index;
+  return 0;
+}
+
+int radiointerferometry_iers_cursor_get(
+  radiointerferometry_iers_cursor_t* cursor,
+  double mjd,
+  double values[RADIOINTERFEROMETRY_IERS_COLUMN_COUNT]
+) {
+  double fraction = mjd - cursor->mjd_lower;
+  // NaN (no bracket yet) fails both comparisons
+  if (!(fraction >= 0.0 && fraction < 1.0)) {
+    int rv = _iers_cursor_bracket(cursor, mjd);
+    if (rv != 0) {
+      return rv;
+    }
+    fraction = mjd - cursor->mjd_lower;
+  }
+  if (fraction != 0.0 && !cursor->interpolable) {
+    // cannot interperolate, MJD clipped
+    for (int column = 0; column < RADIOINTERFEROMETRY_IERS_COLUMN_COUNT; column++) {
+      if (cursor->column_mask & RADIOINTERFEROMETRY_IERS_COLUMN_MASK(column)) {
+        values[column] = cursor->value[column];
+      }
+    }
+    return cursor->mjd_lower + 1.0 < cursor->table->mjd_start + cursor->table->record_count ? 5 : 4;
+  }
+
+  for (int column = 0; column < RADIOINTERFEROMETRY_IERS_COLUMN_COUNT; column++) {
+    if (cursor->column_mask & RADIOINTERFEROMETRY_IERS_COLUMN_MASK(column)) {
+      values[column] = fma(fraction, cursor->slope[column], cursor->value[column]);
+    }
+  }
+  return 0;
+}
+
+int radiointerferometry_iers_table_get_many(
+  const radiointerferometry_iers_table_t* table,
+  const double* mjd,
+  size_t count,
+  uint32_t column_mask,
+  double* columns[RADIOINTERFEROMETRY_IERS_COLUMN_COUNT]
+) {
+  radiointerferometry_iers_cursor_t cursor;
+  radiointerferometry_iers_cursor_init(&cursor, table, column_mask);
 
+  double values[RADIOINTERFEROMETRY_IERS_COLUMN_COUNT];
+  int rv;
+  for (size_t i = 0; i < count; i++) {
+    rv = radiointerferometry_iers_cursor_get(&cursor, mjd[i], values);
+    if (rv != 0) {
+      return (i+1)*10+(rv+1);
+    }
+    for (int column = 0; column < RADIOINTERFEROMETRY_IERS_COLUMN_COUNT; column++) {
+      if (cursor.column_mask & RADIOINTERFEROMETRY_IERS_COLUMN_MASK(column)) {
+        columns[column][i] = values[column];
+      }
+    }
+  }
   return 0;
 }
\ No newline at end of file
@@ -0,0 +1,176 @@
+#define _POSIX_C_SOURCE 200809L
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <radiointerferometryc99/iers.h>
+
+static int _iers_cache_write_all(
+  int fd,
+  const void* buffer,
+  size_t size
+) {
+  ssize_t write_rv;
+  while (size > 0) {
+    write_rv = write(fd, buffer, size);
+    if (write_rv <= 0) {
+      return 1;
+    }
+    buffer = (const char*)buffer + write_rv;
+    size -= write_rv;
+  }
+  return 0;
+}
+
+static char* _iers_cache_default_filepath(
+  const char* filepath
+) {
+  size_t filepath_length = strlen(filepath);
+  char* cache_filepath = malloc(filepath_length + sizeof(".cache"));
+  if (cache_filepath != NULL) {
+    memcpy(cache_filepath, filepath, filepath_length);
+    memcpy(cache_filepath + filepath_length, ".cache", sizeof(".cache"));
+  }
+  return cache_filepath;
+}
+
+int radiointerferometry_iers_cache_write(
+  const char* filepath,
+  const char* cache_filepath
+) {
+  struct stat source_stat;
+  if (stat(filepath, &source_stat) != 0) {
+    return 1;
+  }
+
+  radiointerferometry_iers_table_t table = {0};
+  int rv = radiointerferometry_iers_table_load(filepath, &table);
+  if (rv != 0) {
+    return rv;
+  }
+
+  // zeroed whole, padding included, as it is written out
+  radiointerferometry_iers_cache_header_t header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, RADIOINTERFEROMETRY_IERS_CACHE_MAGIC, sizeof(header.magic));
+  header.version = RADIOINTERFEROMETRY_IERS_CACHE_VERSION;
+  header.column_count = RADIOINTERFEROMETRY_IERS_COLUMN_COUNT;
+  header.source_size = source_stat.st_size;
+  header.source_mtime_sec = source_stat.st_mtim.tv_sec;
+  header.source_mtime_nsec = source_stat.st_mtim.tv_nsec;
+  header.mjd_start = table.mjd_start;
+  header.record_count = table.record_count;
+
+  // write aside, then rename into place
+  size_t cache_filepath_length = strlen(cache_filepath);
+  char* temporary_filepath = malloc(cache_filepath_length + 32);
+  if (temporary_filepath == NULL) {
+    radiointerferometry_iers_table_free(&table);
+    return 6;
+  }
+  snprintf(temporary_filepath, cache_filepath_length + 32, "%s.%ld.tmp", cache_filepath, (long)getpid());
+
+  int fd = open(temporary_filepath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    free(temporary_filepath);
+    radiointerferometry_iers_table_free(&table);
+    return 7;
+  }
+  rv = _iers_cache_write_all(fd, &header, sizeof(header));
+  for (int column = 0; rv == 0 && column < RADIOINTERFEROMETRY_IERS_COLUMN_COUNT; column++) {
+    rv = _iers_cache_write_all(fd, table.columns[column], table.record_count*sizeof(double));
+  }
+  radiointerferometry_iers_table_free(&table);
+  if (close(fd) != 0 || rv != 0 || rename(temporary_filepath, cache_filepath) != 0) {
+    unlink(temporary_filepath);
+    free(temporary_filepath);
+    return 7;
+  }
+  free(temporary_filepath);
+  return 0;
+}
+
+/*
+* Returns:
+*  0: success
+*  1: the cache is absent, invalid or stale
+*  8: error mapping cache_filepath
+*/
+static int _iers_cache_map(
+  const struct stat* source_stat,
+  const char* cache_filepath,
+  radiointerferometry_iers_table_t* table
+) {
+  int fd = open(cache_filepath, O_RDONLY);
+  if (fd < 0) {
+    return 1;
+  }
+  struct stat cache_stat;
+  if (fstat(fd, &cache_stat) != 0 || (size_t)cache_stat.st_size < sizeof(radiointerferometry_iers_cache_header_t)) {
+    close(fd);
+    return 1;
+  }
+
+  void* mapping = mmap(NULL, cache_stat.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (mapping == MAP_FAILED) {
+    return 8;
+  }
+
+  const radiointerferometry_iers_cache_header_t* header = mapping;
+  if (
+    memcmp(header->magic, RADIOINTERFEROMETRY_IERS_CACHE_MAGIC, sizeof(header->magic)) != 0
+    || header->version != RADIOINTERFEROMETRY_IERS_CACHE_VERSION
+    || header->column_count != RADIOINTERFEROMETRY_IERS_COLUMN_COUNT
+    || header->source_size != (uint64_t)source_stat->st_size
+    || header->source_mtime_sec != source_stat->st_mtim.tv_sec
+    || header->source_mtime_nsec != source_stat->st_mtim.tv_nsec
+    || (size_t)cache_stat.st_size != sizeof(*header) + RADIOINTERFEROMETRY_IERS_COLUMN_COUNT*header->record_count*sizeof(double)
+  ) {
+    munmap(mapping, cache_stat.st_size);
+    return 1;
+  }
+
+  table->mjd_start = header->mjd_start;
+  table->record_count = header->record_count;
+  double* column_storage = (double*)(header + 1);
+  for (int column = 0; column < RADIOINTERFEROMETRY_IERS_COLUMN_COUNT; column++) {
+    table->columns[column] = column_storage + column*table->record_count;
+  }
+  table->_storage = mapping;
+  table->_storage_mapping_size = cache_stat.st_size;
+  return 0;
+}
+
+int radiointerferometry_iers_table_open_cache(
+  const char* filepath,
+  const char* cache_filepath,
+  radiointerferometry_iers_table_t* table
+) {
+  struct stat source_stat;
+  if (stat(filepath, &source_stat) != 0) {
+    return 1;
+  }
+
+  char* default_cache_filepath = NULL;
+  if (cache_filepath == NULL) {
+    default_cache_filepath = _iers_cache_default_filepath(filepath);
+    if (default_cache_filepath == NULL) {
+      return 6;
+    }
+    cache_filepath = default_cache_filepath;
+  }
+
+  int rv = _iers_cache_map(&source_stat, cache_filepath, table);
+  if (rv == 1) {
+    rv = radiointerferometry_iers_cache_write(filepath, cache_filepath);
+    if (rv == 0) {
+      rv = _iers_cache_map(&source_stat, cache_filepath, table);
+      // the IERS file changed while it was cached
+      rv = rv == 1 ? 7 : rv;
+    }
+  }
+
+  free(default_cache_filepath);
+  return rv;
+}
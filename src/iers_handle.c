@@ -0,0 +1,221 @@
+#define _POSIX_C_SOURCE 200809L
+#include <string.h>
+#include <time.h>
+#include <sys/stat.h>
+
+#include <radiointerferometryc99/iers.h>
+
+/*
+* Readers count themselves against the reader counter of the epoch's parity.
+* The atomics are GCC/Clang builtins, as C99 has none.
+*/
+
+const radiointerferometry_iers_table_t* radiointerferometry_iers_handle_acquire(
+  radiointerferometry_iers_handle_t* handle,
+  unsigned* ticket
+) {
+  *ticket = __atomic_load_n(&handle->_epoch, __ATOMIC_SEQ_CST) & 1;
+  __atomic_add_fetch(&handle->_readers[*ticket], 1, __ATOMIC_SEQ_CST);
+  return __atomic_load_n(&handle->_table, __ATOMIC_SEQ_CST);
+}
+
+void radiointerferometry_iers_handle_release(
+  radiointerferometry_iers_handle_t* handle,
+  unsigned ticket
+) {
+  __atomic_sub_fetch(&handle->_readers[ticket], 1, __ATOMIC_SEQ_CST);
+}
+
+int radiointerferometry_iers_handle_get(
+  radiointerferometry_iers_handle_t* handle,
+  radiointerferometry_iers_record_t* record
+) {
+  unsigned ticket;
+  const radiointerferometry_iers_table_t* table = radiointerferometry_iers_handle_acquire(handle, &ticket);
+  int rv = radiointerferometry_iers_table_get(table, record);
+  radiointerferometry_iers_handle_release(handle, ticket);
+  return rv;
+}
+
+/*
+* Waits until no reader can still hold a table unpublished before the call.
+* Each reader counter is waited on once it is no longer the epoch's, so that
+* the wait is not prolonged by new readers. Both counters are waited on, as a
+* reader may have taken the parity before one flip and counted itself after it.
+*/
+static void _iers_handle_synchronize(
+  radiointerferometry_iers_handle_t* handle
+) {
+  const struct timespec backoff = {0, 100000};
+  unsigned parity;
+  for (int flip = 0; flip < 2; flip++) {
+    parity = __atomic_fetch_add(&handle->_epoch, 1, __ATOMIC_SEQ_CST) & 1;
+    while (__atomic_load_n(&handle->_readers[parity], __ATOMIC_SEQ_CST) != 0) {
+      nanosleep(&backoff, NULL);
+    }
+  }
+}
+
+static int _iers_handle_load(
+  radiointerferometry_iers_handle_t* handle,
+  radiointerferometry_iers_table_t** table
+) {
+  struct stat file_stat;
+  if (stat(handle->filepath, &file_stat) != 0) {
+    return 1;
+  }
+  *table = calloc(1, sizeof(radiointerferometry_iers_table_t));
+  if (*table == NULL) {
+    return 6;
+  }
+  int rv = radiointerferometry_iers_table_load(handle->filepath, *table);
+  if (rv != 0) {
+    free(*table);
+    *table = NULL;
+    return rv;
+  }
+  handle->_loaded_size = file_stat.st_size;
+  handle->_loaded_mtime_sec = file_stat.st_mtim.tv_sec;
+  handle->_loaded_mtime_nsec = file_stat.st_mtim.tv_nsec;
+  return 0;
+}
+
+int radiointerferometry_iers_handle_init(
+  radiointerferometry_iers_handle_t* handle,
+  const char* filepath
+) {
+  memset(handle, 0, sizeof(*handle));
+  handle->filepath = malloc(strlen(filepath)+1);
+  if (handle->filepath == NULL) {
+    return 6;
+  }
+  strcpy(handle->filepath, filepath);
+  pthread_mutex_init(&handle->_reload_mutex, NULL);
+  pthread_mutex_init(&handle->_watch_mutex, NULL);
+  pthread_cond_init(&handle->_watch_cond, NULL);
+
+  int rv = _iers_handle_load(handle, &handle->_table);
+  if (rv != 0) {
+    radiointerferometry_iers_handle_free(handle);
+  }
+  return rv;
+}
+
+/*
+* Takes `_reload_mutex` held, which also guards the `_loaded_*` fields.
+*/
+static int _iers_handle_reload_locked(
+  radiointerferometry_iers_handle_t* handle
+) {
+  radiointerferometry_iers_table_t* table;
+  int rv = _iers_handle_load(handle, &table);
+  if (rv == 0) {
+    table = __atomic_exchange_n(&handle->_table, table, __ATOMIC_SEQ_CST);
+    _iers_handle_synchronize(handle);
+    radiointerferometry_iers_table_free(table);
+    free(table);
+  }
+  return rv;
+}
+
+int radiointerferometry_iers_handle_reload(
+  radiointerferometry_iers_handle_t* handle
+) {
+  pthread_mutex_lock(&handle->_reload_mutex);
+  int rv = _iers_handle_reload_locked(handle);
+  pthread_mutex_unlock(&handle->_reload_mutex);
+  return rv;
+}
+
+/*
+* Takes `_reload_mutex` held, as the `_loaded_*` fields are written under it.
+*/
+static bool _iers_handle_file_changed(
+  radiointerferometry_iers_handle_t* handle
+) {
+  struct stat file_stat;
+  if (stat(handle->filepath, &file_stat) != 0) {
+    return false;
+  }
+  return file_stat.st_size != handle->_loaded_size
+    || file_stat.st_mtim.tv_sec != handle->_loaded_mtime_sec
+    || file_stat.st_mtim.tv_nsec != handle->_loaded_mtime_nsec;
+}
+
+static void* _iers_handle_watcher(
+  void* handle_void
+) {
+  radiointerferometry_iers_handle_t* handle = handle_void;
+  struct timespec wake;
+  double period_seconds;
+
+  pthread_mutex_lock(&handle->_watch_mutex);
+  while (handle->_watching) {
+    period_seconds = handle->_watch_period;
+    clock_gettime(CLOCK_REALTIME, &wake);
+    wake.tv_sec += (time_t) period_seconds;
+    wake.tv_nsec += (long) ((period_seconds - (time_t) period_seconds)*1e9);
+    if (wake.tv_nsec >= 1000000000) {
+      wake.tv_sec += 1;
+      wake.tv_nsec -= 1000000000;
+    }
+    pthread_cond_timedwait(&handle->_watch_cond, &handle->_watch_mutex, &wake);
+    if (!handle->_watching) {
+      break;
+    }
+
+    pthread_mutex_unlock(&handle->_watch_mutex);
+    // the check and the reload are one step against explicit reloads
+    pthread_mutex_lock(&handle->_reload_mutex);
+    if (_iers_handle_file_changed(handle)) {
+      _iers_handle_reload_locked(handle);
+    }
+    pthread_mutex_unlock(&handle->_reload_mutex);
+    pthread_mutex_lock(&handle->_watch_mutex);
+  }
+  pthread_mutex_unlock(&handle->_watch_mutex);
+  return NULL;
+}
+
+int radiointerferometry_iers_handle_watch(
+  radiointerferometry_iers_handle_t* handle,
+  double period_seconds
+) {
+  pthread_mutex_lock(&handle->_watch_mutex);
+  handle->_watch_period = period_seconds;
+  if (handle->_watching) {
+    pthread_mutex_unlock(&handle->_watch_mutex);
+    return 0;
+  }
+  handle->_watching = true;
+  int rv = pthread_create(&handle->_watcher, NULL, _iers_handle_watcher, handle);
+  if (rv != 0) {
+    handle->_watching = false;
+  }
+  pthread_mutex_unlock(&handle->_watch_mutex);
+  return rv;
+}
+
+void radiointerferometry_iers_handle_free(
+  radiointerferometry_iers_handle_t* handle
+) {
+  pthread_mutex_lock(&handle->_watch_mutex);
+  bool watching = handle->_watching;
+  handle->_watching = false;
+  pthread_cond_signal(&handle->_watch_cond);
+  pthread_mutex_unlock(&handle->_watch_mutex);
+  if (watching) {
+    pthread_join(handle->_watcher, NULL);
+  }
+
+  if (handle->_table != NULL) {
+    radiointerferometry_iers_table_free(handle->_table);
+    free(handle->_table);
+    handle->_table = NULL;
+  }
+  free(handle->filepath);
+  handle->filepath = NULL;
+  pthread_mutex_destroy(&handle->_reload_mutex);
+  pthread_mutex_destroy(&handle->_watch_mutex);
+  pthread_cond_destroy(&handle->_watch_cond);
+}
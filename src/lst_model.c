@@ -0,0 +1,80 @@
+#include "radiointerferometryc99.h"
+
+/*
+ * A non-positive `span_seconds` is CALC_LST_MODEL_SPAN_SECONDS.
+ */
+void calc_lst_model_init(
+	calc_lst_model_t* model,
+	double longitude_rad,
+	double span_seconds
+) {
+	model->longitude_rad = longitude_rad;
+	model->span_days = (span_seconds > 0 ? span_seconds : CALC_LST_MODEL_SPAN_SECONDS) / RADIOINTERFEROMETERY_DAYSEC;
+	model->anchor_date1 = NAN;
+	model->anchor_date2 = NAN;
+	model->max_deviation_rad = 0.0;
+	model->anchor_count = 0;
+}
+
+/*
+ * GST - ERA, the negated equation of the origins, per `calc_lst`.
+ */
+static double _lst_model_correction(
+	double date1,
+	double date2
+) {
+	return eraAnpm(calc_lst(date1, date2) - eraEra00(date1, date2));
+}
+
+/*
+ * Anchors the model at the date, with the correction at either end of its
+ * span, then checks the model against `calc_lst` midway, where the error of
+ * the linear correction peaks.
+ */
+static void _lst_model_anchor(
+	calc_lst_model_t* model,
+	double date1,
+	double date2
+) {
+	const double correction = _lst_model_correction(date1, date2);
+	const double correction_end = _lst_model_correction(date1, date2 + model->span_days);
+	model->anchor_date1 = date1;
+	model->anchor_date2 = date2;
+	model->base_rad = eraEra00(date1, date2) + correction + model->longitude_rad;
+	model->rate_rad_per_day = RADIOINTERFEROMETERY_EARTH_ROTATION_RATE*RADIOINTERFEROMETERY_DAYSEC
+		+ (correction_end - correction)/model->span_days;
+	model->anchor_count++;
+
+	const double midway = date2 + model->span_days/2;
+	const double deviation = fabs(eraAnpm(
+		(model->base_rad + model->rate_rad_per_day*(model->span_days/2))
+		- (calc_lst(date1, midway) + model->longitude_rad)
+	));
+	if (deviation > model->max_deviation_rad) {
+		model->max_deviation_rad = deviation;
+	}
+}
+
+/*
+ * The LST (radians, `calc_lst` plus the longitude) at each of the dates
+ * `date1 + date2[i]`, the model re-anchoring whenever a date falls outside its
+ * span. Dates are as for `calc_lst`, i.e. UT1 (also taken for TT).
+ */
+void calc_lst_model_evaluate(
+	calc_lst_model_t* model,
+	double date1,
+	const double* date2,
+	size_t count,
+	double* lst
+) {
+	double offset_days;
+	for (size_t i = 0; i < count; i++) {
+		offset_days = (date1 - model->anchor_date1) + (date2[i] - model->anchor_date2);
+		// NaN (no anchor yet) fails both comparisons
+		if (!(offset_days >= 0.0 && offset_days <= model->span_days)) {
+			_lst_model_anchor(model, date1, date2[i]);
+			offset_days = 0.0;
+		}
+		lst[i] = eraAnp(model->base_rad + model->rate_rad_per_day*offset_days);
+	}
+}
@@ -1,3 +1,4 @@
+#include <stdlib.h>
 #include <string.h>
 
 #include "radiointerferometryc99.h"
@@ -13,9 +14,11 @@ int _itrs_transform_app_to_icrs(
   double* pm_y_arcsec,
   double* ut1_utc_sec,
   size_t count,
+  size_t dec_count,
   double longitude_rad,
   double latitude_rad,
   double altitude,
+  calc_precession_nutation_t* precession_nutation,
   double* icrs_ra,
   double* icrs_dec
 ) {
@@ -28,6 +31,11 @@ int _itrs_transform_app_to_icrs(
   this is only implemented in astropy and pyERFA, although it could hypothetically
   be extended to NOVAS at some point.
 
+  The date-dependent work (precession-nutation and the star-independent
+  astrometry parameters) is done once per unique time, that is whenever the
+  time, polar motion or UT1-UTC differ from the previous element's, and reused
+  for each of the `dec_count` declinations of the element.
+
   Parameters
   ----------
   time_jd :
@@ -35,16 +43,24 @@ int _itrs_transform_app_to_icrs(
   app_ra_radians :
     ICRS RA of the celestial target, expressed in units of radians.
   app_dec_radians :
-    ICRS Dec of the celestial target, expressed in units of radians.
+    ICRS Dec of the celestial target, expressed in units of radians. Holds
+    `dec_count` sets of `count` declinations, all sharing `app_ra_radians`.
   count :
-    The number of elements behind each of the 3 pointers.
+    The number of elements behind each of the pointers.
+  dec_count :
+    The number of declination sets.
+  precession_nutation :
+    The precession-nutation tier of the star-independent parameters and the
+    equation of the origins, NULL for the full series as eraAtoc13.
 
   Returns
   -------
   icrs_ra :
-    ICRS right ascension coordinates, in units of radians. Taken to be allocated.
+    ICRS right ascension coordinates, in units of radians. Taken to be allocated,
+    laid out as `app_dec_radians`.
   icrs_dec :
-    ICRS declination coordinates, in units of radians. Taken to be allocated.
+    ICRS declination coordinates, in units of radians. Taken to be allocated,
+    laid out as `app_dec_radians`.
 
   : int
     Zero if success, otherwise `(index+1)*10+errcode` encoding the index of the
@@ -53,46 +69,67 @@ int _itrs_transform_app_to_icrs(
     - 1 being unacceptable date.
     - [2, 8] being iers_get() errcode + 3
   */
-  double rbpn_matrix[3][3];
-  double cip_x, cip_y;
-  double cio_s;
+  calc_precession_nutation_t full_series;
   double eqn_org;
+  double ri, di;
+  eraASTROM astrom;
   int rv;
+  if (precession_nutation == NULL) {
+    calc_precession_nutation_init(&full_series, PRECESSION_NUTATION_IAU2006A, 0);
+    precession_nutation = &full_series;
+  }
   for (size_t i = 0; i < count; i++) {
-    eraPnm06a(time_jd[i], 0, rbpn_matrix);
-    eraBpn2xy(rbpn_matrix, &cip_x, &cip_y);
-    cio_s = eraS06(time_jd[i], 0, cip_x, cip_y);
-    eqn_org = eraEors(rbpn_matrix, cio_s);
-
-    // Observed to ICRS via ERFA
-    // status: +1 = dubious year (Note 4), 0 = OK, -1 = unacceptable date
-    rv = eraAtoc13(
-      "R",
-      app_ra_radians[i] + eqn_org,
-      app_dec_radians[i],
-      time_jd[i], 0,
-      ut1_utc_sec[i],
-      longitude_rad,
-      latitude_rad,
-      altitude,
-      pm_x_arcsec[i] * (RADIOINTERFEROMETERY_PI/(180 * 3600)), // convert arcsec to radian
-      pm_y_arcsec[i] * (RADIOINTERFEROMETERY_PI/(180 * 3600)), // convert arcsec to radian
-      0, // atm pressure, used for refraction (ignored)
-      0, // amb temperature, used for refraction (ignored)
-      0, // rel humidity, used for refraction (ignored)
-      0, // wavelength, used for refraction (ignored)
-      icrs_ra + i,
-      icrs_dec + i
-    );
-    if (rv != 0) {
-      // {-1, +1} -> {1, 0}
-      return (i+1)*10+((rv+2)%3);
+    if (
+      i == 0
+      || time_jd[i] != time_jd[i-1]
+      || ut1_utc_sec[i] != ut1_utc_sec[i-1]
+      || pm_x_arcsec[i] != pm_x_arcsec[i-1]
+      || pm_y_arcsec[i] != pm_y_arcsec[i-1]
+    ) {
+      // Star-independent parameters, as eraAtoc13 computes them, with the
+      // precession-nutation evaluated once (at TT) for both them and the
+      // equation of the origins
+      // status: +1 = dubious year (Note 4), 0 = OK, -1 = unacceptable date
+      rv = calc_independent_astrom_with_precession_nutation(
+        precession_nutation,
+        longitude_rad,
+        latitude_rad,
+        altitude,
+        time_jd[i], 0,
+        ut1_utc_sec[i],
+        pm_x_arcsec[i] * (RADIOINTERFEROMETERY_PI/(180 * 3600)), // convert arcsec to radian
+        pm_y_arcsec[i] * (RADIOINTERFEROMETERY_PI/(180 * 3600)), // convert arcsec to radian
+        &astrom,
+        &eqn_org
+      );
+      if (rv != 0) {
+        // {-1, +1} -> {1, 0}
+        return (i+1)*10+((rv+2)%3);
+      }
+    }
+
+    // Observed to ICRS via ERFA, as eraAtoc13
+    for (size_t j = i; j < dec_count*count; j += count) {
+      eraAtoiq(
+        "R",
+        app_ra_radians[i] + eqn_org,
+        app_dec_radians[j],
+        &astrom,
+        &ri, &di
+      );
+      eraAticq(ri, di, &astrom, icrs_ra + j, icrs_dec + j);
     }
   }
   
   return 0;
 }
 
+size_t calc_itrs_icrs_frame_pos_angle_workspace_size(size_t count) {
+  // offset declinations and their ICRS coordinates, 2*count each, preceded
+  // by the polar motion and UT1-UTC of the IERS accessing variants
+  return 9*count*sizeof(double);
+}
+
 int calc_itrs_icrs_frame_pos_angle(
   double* time_jd,
   double* app_ra_radians,
@@ -108,51 +145,166 @@ int calc_itrs_icrs_frame_pos_angle(
   /*
   Calculate an position angle given apparent position and reference frame.
 
-  Accesses IERS data then calls `calc_itrs_icrs_frame_pos_angle_with_pm_and_ut1_utc`
+  Accesses IERS data then calls `calc_itrs_icrs_frame_pos_angle_with_pm_and_ut1_utc`,
+  returning 6 if its workspace cannot be allocated.
   */
 
   // Get IERS data, which is needed for highest precision
   radiointerferometry_iers_record_t iers_rec = {0};
-  double* pm_x_arcsec = malloc(count*sizeof(double));
-  double* pm_y_arcsec = malloc(count*sizeof(double));
-  double* ut1_utc_sec = malloc(count*sizeof(double));
+  double* pm_x_arcsec = malloc(calc_itrs_icrs_frame_pos_angle_workspace_size(count));
+  if (pm_x_arcsec == NULL && count > 0) {
+    return 6;
+  }
+  double* pm_y_arcsec = pm_x_arcsec + count;
+  double* ut1_utc_sec = pm_y_arcsec + count;
+  size_t looked_up_count = 0;
+  int lookup_rv = 0;
   int rv;
   
-  for (size_t i = 0; i < count; i++) {
-    iers_rec.mjd = time_jd[i] - 2400000.5;
+  for (; looked_up_count < count; looked_up_count++) {
+    iers_rec.mjd = time_jd[looked_up_count] - 2400000.5;
     rv = radiointerferometry_iers_get(
       iers_filepath,
       &iers_rec
     );
     if (rv != 0) {
-      return (i+1)*10+(rv+3);
+      lookup_rv = (looked_up_count+1)*10+(rv+3);
+      break;
     }
-    pm_x_arcsec[i] = iers_rec.pm_x_a;
-    pm_y_arcsec[i] = iers_rec.pm_y_a;
-    ut1_utc_sec[i] = iers_rec.ut1_utc_a;
+    pm_x_arcsec[looked_up_count] = iers_rec.pm_x_a;
+    pm_y_arcsec[looked_up_count] = iers_rec.pm_y_a;
+    ut1_utc_sec[looked_up_count] = iers_rec.ut1_utc_a;
   }
 
-  rv = calc_itrs_icrs_frame_pos_angle_with_pm_and_ut1_utc(
+  // the elements preceding an erroneous lookup are computed regardless, as
+  // are those preceding an erroneous transform
+  rv = calc_itrs_icrs_frame_pos_angle_with_pm_and_ut1_utc_workspace(
     time_jd,
     app_ra_radians,
     app_dec_radians,
     pm_x_arcsec,
     pm_y_arcsec,
     ut1_utc_sec,
-    count,
+    looked_up_count,
     longitude_rad,
     latitude_rad,
     altitude,
     offset_pos,
+    ut1_utc_sec + count,
     pos_angle
   );
+  if (rv == 0) {
+    rv = lookup_rv;
+  }
 
   free(pm_x_arcsec);
-  free(pm_y_arcsec);
-  free(ut1_utc_sec);
   return rv;
 }
 
+int calc_itrs_icrs_frame_pos_angle_with_iers_table(
+  double* time_jd,
+  double* app_ra_radians,
+  double* app_dec_radians,
+  size_t count,
+  double longitude_rad,
+  double latitude_rad,
+  double altitude,
+  double offset_pos,
+  const radiointerferometry_iers_table_t* iers_table,
+  double* pos_angle
+) {
+  /*
+  Calculate an position angle given apparent position and reference frame.
+
+  As `calc_itrs_icrs_frame_pos_angle`, but accesses IERS data from a table
+  loaded by `radiointerferometry_iers_table_load`, which avoids any file access.
+  Returns 6 if the workspace cannot be allocated.
+  */
+
+  void* workspace = malloc(calc_itrs_icrs_frame_pos_angle_workspace_size(count));
+  if (workspace == NULL && count > 0) {
+    return 6;
+  }
+  int rv = calc_itrs_icrs_frame_pos_angle_with_iers_table_workspace(
+    time_jd,
+    app_ra_radians,
+    app_dec_radians,
+    count,
+    longitude_rad,
+    latitude_rad,
+    altitude,
+    offset_pos,
+    iers_table,
+    workspace,
+    pos_angle
+  );
+  free(workspace);
+  return rv;
+}
+
+int calc_itrs_icrs_frame_pos_angle_with_iers_table_workspace(
+  double* time_jd,
+  double* app_ra_radians,
+  double* app_dec_radians,
+  size_t count,
+  double longitude_rad,
+  double latitude_rad,
+  double altitude,
+  double offset_pos,
+  const radiointerferometry_iers_table_t* iers_table,
+  void* workspace,
+  double* pos_angle
+) {
+  /*
+  As `calc_itrs_icrs_frame_pos_angle_with_iers_table`, but makes no heap
+  allocations: `workspace` is caller-owned scratch of at least
+  `calc_itrs_icrs_frame_pos_angle_workspace_size(count)` bytes, suitably
+  aligned for doubles.
+  */
+
+  radiointerferometry_iers_record_t iers_rec = {0};
+  double* pm_x_arcsec = (double*) workspace;
+  double* pm_y_arcsec = pm_x_arcsec + count;
+  double* ut1_utc_sec = pm_y_arcsec + count;
+  size_t looked_up_count = 0;
+  int lookup_rv = 0;
+  int rv;
+  
+  for (; looked_up_count < count; looked_up_count++) {
+    iers_rec.mjd = time_jd[looked_up_count] - 2400000.5;
+    rv = radiointerferometry_iers_table_get(
+      iers_table,
+      &iers_rec
+    );
+    if (rv != 0) {
+      lookup_rv = (looked_up_count+1)*10+(rv+3);
+      break;
+    }
+    pm_x_arcsec[looked_up_count] = iers_rec.pm_x_a;
+    pm_y_arcsec[looked_up_count] = iers_rec.pm_y_a;
+    ut1_utc_sec[looked_up_count] = iers_rec.ut1_utc_a;
+  }
+
+  // the elements preceding an erroneous lookup are computed regardless, as
+  // are those preceding an erroneous transform
+  rv = calc_itrs_icrs_frame_pos_angle_with_pm_and_ut1_utc_workspace(
+    time_jd,
+    app_ra_radians,
+    app_dec_radians,
+    pm_x_arcsec,
+    pm_y_arcsec,
+    ut1_utc_sec,
+    looked_up_count,
+    longitude_rad,
+    latitude_rad,
+    altitude,
+    offset_pos,
+    ut1_utc_sec + count,
+    pos_angle
+  );
+  return rv != 0 ? rv : lookup_rv;
+}
+
 int calc_itrs_icrs_frame_pos_angle_with_pm_and_ut1_utc(
   double* time_jd,
   double* app_ra_radians,
@@ -208,30 +360,97 @@ int calc_itrs_icrs_frame_pos_angle_with_pm_and_ut1_utc(
     - 0 being dubious year
     - 1 being unacceptable date.
     - >=2 being iers_get() errcode + 1
+    Or 6, not encoding an index, if the workspace cannot be allocated.
   */
 
-  double *_time_jd, *_app_ra_radians, *_app_dec_radians, *_pm_x_arcsec, *_pm_y_arcsec, *_ut1_utc_sec, *icrs_ra, *icrs_dec;
-  size_t array_size = sizeof(double)*count;
-
-  _time_jd = malloc(2*array_size);
-  _app_ra_radians = malloc(2*array_size);
-  _app_dec_radians = malloc(2*array_size);
-  _pm_x_arcsec = malloc(2*array_size);
-  _pm_y_arcsec = malloc(2*array_size);
-  _ut1_utc_sec = malloc(2*array_size);
-  icrs_ra = malloc(2*array_size);
-  icrs_dec = malloc(2*array_size);
-  
-  memcpy(_time_jd, time_jd, array_size);
-  memcpy(_time_jd+count, time_jd, array_size);
-  memcpy(_app_ra_radians, app_ra_radians, array_size);
-  memcpy(_app_ra_radians+count, app_ra_radians, array_size);
-  memcpy(_pm_x_arcsec, pm_x_arcsec, array_size);
-  memcpy(_pm_x_arcsec+count, pm_x_arcsec, array_size);
-  memcpy(_pm_y_arcsec, pm_y_arcsec, array_size);
-  memcpy(_pm_y_arcsec+count, pm_y_arcsec, array_size);
-  memcpy(_ut1_utc_sec, ut1_utc_sec, array_size);
-  memcpy(_ut1_utc_sec+count, ut1_utc_sec, array_size);
+  void* workspace = malloc(calc_itrs_icrs_frame_pos_angle_workspace_size(count));
+  if (workspace == NULL && count > 0) {
+    return 6;
+  }
+  int rv = calc_itrs_icrs_frame_pos_angle_with_pm_and_ut1_utc_workspace(
+    time_jd,
+    app_ra_radians,
+    app_dec_radians,
+    pm_x_arcsec,
+    pm_y_arcsec,
+    ut1_utc_sec,
+    count,
+    longitude_rad,
+    latitude_rad,
+    altitude,
+    offset_pos,
+    workspace,
+    pos_angle
+  );
+  free(workspace);
+  return rv;
+}
+
+int calc_itrs_icrs_frame_pos_angle_with_pm_and_ut1_utc_workspace(
+  double* time_jd,
+  double* app_ra_radians,
+  double* app_dec_radians,
+  double* pm_x_arcsec,
+  double* pm_y_arcsec,
+  double* ut1_utc_sec,
+  size_t count,
+  double longitude_rad,
+  double latitude_rad,
+  double altitude,
+  double offset_pos,
+  void* workspace,
+  double* pos_angle
+) {
+  /*
+  As `calc_itrs_icrs_frame_pos_angle_with_pm_and_ut1_utc`, but makes no heap
+  allocations: `workspace` is caller-owned scratch of at least
+  `calc_itrs_icrs_frame_pos_angle_workspace_size(count)` bytes, suitably
+  aligned for doubles.
+  */
+  return calc_itrs_icrs_frame_pos_angle_with_precession_nutation(
+    time_jd,
+    app_ra_radians,
+    app_dec_radians,
+    pm_x_arcsec,
+    pm_y_arcsec,
+    ut1_utc_sec,
+    count,
+    longitude_rad,
+    latitude_rad,
+    altitude,
+    offset_pos,
+    NULL,
+    workspace,
+    pos_angle
+  );
+}
+
+int calc_itrs_icrs_frame_pos_angle_with_precession_nutation(
+  double* time_jd,
+  double* app_ra_radians,
+  double* app_dec_radians,
+  double* pm_x_arcsec,
+  double* pm_y_arcsec,
+  double* ut1_utc_sec,
+  size_t count,
+  double longitude_rad,
+  double latitude_rad,
+  double altitude,
+  double offset_pos,
+  calc_precession_nutation_t* precession_nutation,
+  void* workspace,
+  double* pos_angle
+) {
+  /*
+  As `calc_itrs_icrs_frame_pos_angle_with_pm_and_ut1_utc_workspace`, with the
+  star-independent parameters to the precession-nutation tier (NULL for the
+  full series, as eraAtoc13).
+  */
+
+  double* _app_dec_radians = (double*) workspace;
+  double* icrs_ra = _app_dec_radians + 2*count;
+  double* icrs_dec = icrs_ra + 2*count;
+
   for (size_t i = 0; i < count; i++) {
     _app_dec_radians[i] = app_dec_radians[i] - offset_pos;
     // Wrap the positions if they happen to go over the poles
@@ -247,40 +466,255 @@ int calc_itrs_icrs_frame_pos_angle_with_pm_and_ut1_utc(
   }
 
   // Run the set of offset coordinates through the "reverse" transform. The two offset
-  // positions are concat'd together to help reduce overheads
+  // positions share each element's date-dependent work
   int rv = _itrs_transform_app_to_icrs(
-    _time_jd,
-    _app_ra_radians,
+    time_jd,
+    app_ra_radians,
     _app_dec_radians,
-    _pm_x_arcsec,
-    _pm_y_arcsec,
-    _ut1_utc_sec,
-    2*count,
+    pm_x_arcsec,
+    pm_y_arcsec,
+    ut1_utc_sec,
+    count,
+    2,
     longitude_rad,
     latitude_rad,
     altitude,
+    precession_nutation,
     icrs_ra,
     icrs_dec
   );
-  if (rv != 0) {
-    count = ((rv/10)-1)/2;
-  }
+  // only the elements preceding an erroneous one are transformed
+  size_t transformed_count = rv != 0 ? (size_t)(rv/10)-1 : count;
 
   // Use the pas function from ERFA to calculate the position angle. The negative sign
   // is here because we're measuring PA of app -> frame, but we want frame -> app.
-  for (size_t i = 0; i < count; i++) {
+  for (size_t i = 0; i < transformed_count; i++) {
     pos_angle[i] = -eraPas(
       icrs_ra[i], icrs_dec[i], icrs_ra[count+i], icrs_dec[count+i]
     );
   }
 
-  free(_time_jd);
-  free(_app_ra_radians);
-  free(_app_dec_radians);
-  free(_pm_x_arcsec);
-  free(_pm_y_arcsec);
-  free(_ut1_utc_sec);
-  free(icrs_ra);
-  free(icrs_dec);
   return rv;
-}
\ No newline at end of file
+}
+
+typedef struct {
+  double* time_jd;
+  double* app_ra_radians;
+  double* app_dec_radians;
+  double* pm_x_arcsec;
+  double* pm_y_arcsec;
+  double* ut1_utc_sec;
+  const radiointerferometry_iers_table_t* iers_table; // NULL when given pm and ut1_utc
+  size_t begin;
+  size_t end;
+  double longitude_rad;
+  double latitude_rad;
+  double altitude;
+  double offset_pos;
+  double* pos_angle;
+  int* status;
+  void* workspace; // of the chunk's elements
+  size_t error_count;
+} _pos_angle_chunk_t;
+
+static void* _pos_angle_chunk_worker(void* chunk_void) {
+  _pos_angle_chunk_t* chunk = chunk_void;
+  void* workspace = chunk->workspace;
+  size_t i = chunk->begin;
+  int rv;
+
+  memset(chunk->status + chunk->begin, 0, (chunk->end - chunk->begin)*sizeof(int));
+  chunk->error_count = 0;
+  // resume after each erroneous element, which the serial path would stop at
+  while (i < chunk->end) {
+    if (chunk->iers_table != NULL) {
+      rv = calc_itrs_icrs_frame_pos_angle_with_iers_table_workspace(
+        chunk->time_jd + i,
+        chunk->app_ra_radians + i,
+        chunk->app_dec_radians + i,
+        chunk->end - i,
+        chunk->longitude_rad,
+        chunk->latitude_rad,
+        chunk->altitude,
+        chunk->offset_pos,
+        chunk->iers_table,
+        workspace,
+        chunk->pos_angle + i
+      );
+    }
+    else {
+      rv = calc_itrs_icrs_frame_pos_angle_with_pm_and_ut1_utc_workspace(
+        chunk->time_jd + i,
+        chunk->app_ra_radians + i,
+        chunk->app_dec_radians + i,
+        chunk->pm_x_arcsec + i,
+        chunk->pm_y_arcsec + i,
+        chunk->ut1_utc_sec + i,
+        chunk->end - i,
+        chunk->longitude_rad,
+        chunk->latitude_rad,
+        chunk->altitude,
+        chunk->offset_pos,
+        workspace,
+        chunk->pos_angle + i
+      );
+    }
+    if (rv == 0) {
+      break;
+    }
+    i += (rv/10)-1;
+    chunk->status[i] = (rv%10)+1;
+    chunk->pos_angle[i] = NAN;
+    chunk->error_count++;
+    i++;
+  }
+
+  return NULL;
+}
+
+static int _pos_angle_parallel(
+  _pos_angle_chunk_t* template,
+  size_t count,
+  int thread_count
+) {
+  if (thread_count < 1) {
+    thread_count = 1;
+  }
+  if ((size_t)thread_count > count) {
+    thread_count = count > 0 ? (int)count : 1;
+  }
+  // the chunks' workspaces are contiguous slices of the one allocation, the
+  // workspace size being linear in the element count
+  _pos_angle_chunk_t* chunks = malloc(thread_count*sizeof(_pos_angle_chunk_t));
+  pthread_t* threads = malloc(thread_count*sizeof(pthread_t));
+  int* started = calloc(thread_count, sizeof(int));
+  char* workspace = malloc(calc_itrs_icrs_frame_pos_angle_workspace_size(count));
+  if (chunks == NULL || threads == NULL || started == NULL || workspace == NULL) {
+    for (size_t i = 0; i < count; i++) {
+      template->status[i] = 10;
+      template->pos_angle[i] = NAN;
+    }
+    free(chunks);
+    free(threads);
+    free(started);
+    free(workspace);
+    return (int) count;
+  }
+
+  for (int t = 0; t < thread_count; t++) {
+    chunks[t] = *template;
+    chunks[t].begin = (count*t)/thread_count;
+    chunks[t].end = (count*(t+1))/thread_count;
+    chunks[t].workspace = workspace + calc_itrs_icrs_frame_pos_angle_workspace_size(chunks[t].begin);
+    // the calling thread takes the first chunk, and any that fail to start
+    started[t] = t > 0 && pthread_create(threads+t, NULL, _pos_angle_chunk_worker, chunks+t) == 0;
+  }
+  int error_count = 0;
+  for (int t = 0; t < thread_count; t++) {
+    if (started[t]) {
+      pthread_join(threads[t], NULL);
+    }
+    else {
+      _pos_angle_chunk_worker(chunks+t);
+    }
+    error_count += chunks[t].error_count;
+  }
+
+  free(chunks);
+  free(threads);
+  free(started);
+  free(workspace);
+  return error_count;
+}
+
+int calc_itrs_icrs_frame_pos_angle_with_iers_table_parallel(
+  double* time_jd,
+  double* app_ra_radians,
+  double* app_dec_radians,
+  size_t count,
+  double longitude_rad,
+  double latitude_rad,
+  double altitude,
+  double offset_pos,
+  const radiointerferometry_iers_table_t* iers_table,
+  int thread_count,
+  double* pos_angle,
+  int* status
+) {
+  /*
+  As `calc_itrs_icrs_frame_pos_angle_with_iers_table`, with the elements split
+  into `thread_count` contiguous chunks, each computed by its own thread with
+  its own workspace. The results are those of the serial path, bit for bit.
+
+  Erroneous elements do not stop the computation, instead they are reported
+  in `status`.
+
+  Returns
+  -------
+  pos_angle :
+    Array of position angles, in units of radians, NaN for the erroneous
+    elements. Taken to be allocated.
+  status :
+    Array of element statuses. Taken to be allocated. Zero if success,
+    otherwise the serial errcode + 1:
+    - 1 being dubious year
+    - 2 being unacceptable date.
+    - [3, 9] being iers_get() errcode + 4
+    - 10 being an error allocating memory, for all elements
+
+  : int
+    The number of erroneous elements.
+  */
+  _pos_angle_chunk_t template = {
+    .time_jd = time_jd,
+    .app_ra_radians = app_ra_radians,
+    .app_dec_radians = app_dec_radians,
+    .iers_table = iers_table,
+    .longitude_rad = longitude_rad,
+    .latitude_rad = latitude_rad,
+    .altitude = altitude,
+    .offset_pos = offset_pos,
+    .pos_angle = pos_angle,
+    .status = status,
+  };
+  return _pos_angle_parallel(&template, count, thread_count);
+}
+
+int calc_itrs_icrs_frame_pos_angle_with_pm_and_ut1_utc_parallel(
+  double* time_jd,
+  double* app_ra_radians,
+  double* app_dec_radians,
+  double* pm_x_arcsec,
+  double* pm_y_arcsec,
+  double* ut1_utc_sec,
+  size_t count,
+  double longitude_rad,
+  double latitude_rad,
+  double altitude,
+  double offset_pos,
+  int thread_count,
+  double* pos_angle,
+  int* status
+) {
+  /*
+  As `calc_itrs_icrs_frame_pos_angle_with_pm_and_ut1_utc`, parallelised as
+  `calc_itrs_icrs_frame_pos_angle_with_iers_table_parallel`, with the element
+  statuses and return value thereof.
+  */
+  _pos_angle_chunk_t template = {
+    .time_jd = time_jd,
+    .app_ra_radians = app_ra_radians,
+    .app_dec_radians = app_dec_radians,
+    .pm_x_arcsec = pm_x_arcsec,
+    .pm_y_arcsec = pm_y_arcsec,
+    .ut1_utc_sec = ut1_utc_sec,
+    .iers_table = NULL,
+    .longitude_rad = longitude_rad,
+    .latitude_rad = latitude_rad,
+    .altitude = altitude,
+    .offset_pos = offset_pos,
+    .pos_angle = pos_angle,
+    .status = status,
+  };
+  return _pos_angle_parallel(&template, count, thread_count);
+}
@@ -0,0 +1,186 @@
+#include <string.h>
+
+#include "radiointerferometryc99.h"
+
+/*
+ * Per the CIO based precession-nutation of the full series (eraPnm06a): the
+ * CIP X and Y, the CIO locator s and the equation of the origins.
+ */
+static void _precession_nutation_06a(
+	double date1,
+	double date2,
+	double values[4]
+) {
+	double rbpn[3][3];
+	eraPnm06a(date1, date2, rbpn);
+	eraBpn2xy(rbpn, values + 0, values + 1);
+	values[2] = eraS06(date1, date2, values[0], values[1]);
+	values[3] = eraEors(rbpn, values[2]);
+}
+
+static void _precession_nutation_00b(
+	double date1,
+	double date2,
+	double values[4]
+) {
+	double rbpn[3][3];
+	eraPnm00b(date1, date2, rbpn);
+	eraBpn2xy(rbpn, values + 0, values + 1);
+	values[2] = eraS00(date1, date2, values[0], values[1]);
+	values[3] = eraEors(rbpn, values[2]);
+}
+
+/*
+ * A non-positive `anchor_seconds` is CALC_PRECESSION_NUTATION_ANCHOR_SECONDS.
+ */
+void calc_precession_nutation_init(
+	calc_precession_nutation_t* precession_nutation,
+	enum precession_nutation_accuracies accuracy,
+	double anchor_seconds
+) {
+	precession_nutation->accuracy = accuracy;
+	precession_nutation->anchor_days = (anchor_seconds > 0 ? anchor_seconds : CALC_PRECESSION_NUTATION_ANCHOR_SECONDS) / RADIOINTERFEROMETERY_DAYSEC;
+	precession_nutation->origin_date1 = NAN;
+	precession_nutation->origin_date2 = NAN;
+	precession_nutation->anchor_index = 0;
+}
+
+/*
+ * The anchors lie every `anchor_days` from the first date evaluated, a
+ * bracket sliding forward by one anchor reusing its upper anchor.
+ */
+static void _precession_nutation_interpolated(
+	calc_precession_nutation_t* precession_nutation,
+	double date1,
+	double date2,
+	double values[4]
+) {
+	const double anchor_days = precession_nutation->anchor_days;
+	if (isnan(precession_nutation->origin_date1)) {
+		precession_nutation->origin_date1 = date1;
+		precession_nutation->origin_date2 = date2;
+		precession_nutation->anchor_index = 0;
+		_precession_nutation_06a(date1, date2, precession_nutation->lower);
+		_precession_nutation_06a(date1, date2 + anchor_days, precession_nutation->upper);
+	}
+	const double offset_days = (date1 - precession_nutation->origin_date1) + (date2 - precession_nutation->origin_date2);
+	const long anchor_index = (long) floor(offset_days / anchor_days);
+	if (anchor_index != precession_nutation->anchor_index) {
+		if (anchor_index == precession_nutation->anchor_index + 1) {
+			memcpy(precession_nutation->lower, precession_nutation->upper, sizeof(precession_nutation->lower));
+		}
+		else {
+			_precession_nutation_06a(
+				precession_nutation->origin_date1,
+				precession_nutation->origin_date2 + anchor_index*anchor_days,
+				precession_nutation->lower
+			);
+		}
+		_precession_nutation_06a(
+			precession_nutation->origin_date1,
+			precession_nutation->origin_date2 + (anchor_index+1)*anchor_days,
+			precession_nutation->upper
+		);
+		precession_nutation->anchor_index = anchor_index;
+	}
+	const double fraction = offset_days/anchor_days - anchor_index;
+	for (int v = 0; v < 4; v++) {
+		values[v] = precession_nutation->lower[v] + fraction*(precession_nutation->upper[v] - precession_nutation->lower[v]);
+	}
+}
+
+/*
+ * The CIP coordinates `x` and `y`, the CIO locator `s` and the equation of
+ * the origins `eo` (radians) at the TT date `date1 + date2`, to the accuracy
+ * of the tier.
+ */
+void calc_precession_nutation_cip(
+	calc_precession_nutation_t* precession_nutation,
+	double date1,
+	double date2,
+	double* x,
+	double* y,
+	double* s,
+	double* eo
+) {
+	double values[4];
+	switch (precession_nutation->accuracy) {
+		case PRECESSION_NUTATION_IAU2000B:
+			_precession_nutation_00b(date1, date2, values);
+			break;
+		case PRECESSION_NUTATION_INTERPOLATED:
+			_precession_nutation_interpolated(precession_nutation, date1, date2, values);
+			break;
+		default:
+			_precession_nutation_06a(date1, date2, values);
+	}
+	*x = values[0];
+	*y = values[1];
+	*s = values[2];
+	*eo = values[3];
+}
+
+/*
+ * As `calc_lst`, with the equation of the origins of the tier: the dates are
+ * passed as `calc_lst` passes them to eraGst06a, so that with
+ * PRECESSION_NUTATION_IAU2006A the two agree.
+ */
+double calc_lst_with_precession_nutation(
+	calc_precession_nutation_t* precession_nutation,
+	double date1,
+	double date2
+) {
+	double x, y, s, eo;
+	calc_precession_nutation_cip(precession_nutation, date1, date2, &x, &y, &s, &eo);
+	return eraAnp(eraEra00(date1, date2) - eo);
+}
+
+/*
+ * eraApco13 without refraction, with the precession-nutation of the tier.
+ * https://github.com/liberfa/erfa/blob/master/src/apco13.c
+ *
+ * Returns:
+ *  as eraApco13: +1 dubious year, 0 OK, -1 unacceptable date.
+ */
+int calc_independent_astrom_with_precession_nutation(
+	calc_precession_nutation_t* precession_nutation,
+	double longitude_rad,
+	double latitude_rad,
+	double altitude,
+	double date1,
+	double date2,
+	double dut1,
+	double pm_x_rad,
+	double pm_y_rad,
+	eraASTROM* astrom,
+	double* eo
+) {
+	double tai1, tai2, tt1, tt2, ut11, ut12;
+	double ehpv[2][3], ebpv[2][3];
+	double x, y, s;
+	int rv;
+
+	if (eraUtctai(date1, date2, &tai1, &tai2) < 0) {
+		return -1;
+	}
+	eraTaitt(tai1, tai2, &tt1, &tt2);
+	rv = eraUtcut1(date1, date2, dut1, &ut11, &ut12);
+	if (rv < 0) {
+		return -1;
+	}
+
+	eraEpv00(tt1, tt2, ehpv, ebpv);
+	calc_precession_nutation_cip(precession_nutation, tt1, tt2, &x, &y, &s, eo);
+	eraApco(
+		tt1, tt2,
+		ebpv, ehpv[0],
+		x, y, s,
+		eraEra00(ut11, ut12),
+		longitude_rad, latitude_rad, altitude,
+		pm_x_rad, pm_y_rad,
+		eraSp00(tt1, tt2),
+		0, 0,
+		astrom
+	);
+	return rv;
+}
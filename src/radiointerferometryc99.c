@@ -1,3 +1,5 @@
+#include <string.h>
+
 #include "radiointerferometryc99.h"
 
 inline double calc_rad_from_degree(double deg) {
@@ -20,6 +22,101 @@ inline double calc_modified_from_julian_date(double julian_date) {
 	return julian_date - 2400000.5;
 }
 
+/*
+ * The unix seconds of the start of block `pktidx`.
+ */
+double calc_epoch_seconds_from_guppi_param(
+	const double tbin,
+	const size_t sampleperblk,
+	const size_t piperblk,
+	const size_t synctime,
+	const size_t pktidx
+) {
+	return synctime + ((double) pktidx)*tbin*sampleperblk/piperblk;
+}
+
+double calc_julian_date_from_guppi_param(
+	const double tbin,
+	const size_t sampleperblk,
+	const size_t piperblk,
+	const size_t synctime,
+	const size_t pktidx
+) {
+	return calc_julian_date_from_unix_sec(
+		calc_epoch_seconds_from_guppi_param(
+			tbin,
+			sampleperblk,
+			piperblk,
+			synctime,
+			pktidx
+		)
+	);
+}
+
+/*
+ * The integral `synctime` is split into whole days and seconds exactly, so the
+ * fractions resolve the time of each block to the rounding of its offset from
+ * the start of the sync-day: some 10 picoseconds for offsets of a day.
+ */
+void calc_modified_julian_dates_from_guppi_param(
+	const double tbin,
+	const size_t sampleperblk,
+	const size_t piperblk,
+	const size_t synctime,
+	const size_t* pktidx,
+	size_t count,
+	double* mjd_day,
+	double* mjd_fraction
+) {
+	const double block_seconds = tbin*sampleperblk/piperblk;
+	// the unix epoch is MJD 40587
+	const double sync_day = 40587.0 + (double) (synctime / 86400);
+	const double sync_seconds = (double) (synctime % 86400);
+	double seconds, days;
+	for (size_t i = 0; i < count; i++) {
+		seconds = sync_seconds + ((double) pktidx[i])*block_seconds;
+		days = floor(seconds / RADIOINTERFEROMETERY_DAYSEC);
+		mjd_day[i] = sync_day + days;
+		mjd_fraction[i] = (seconds - days*RADIOINTERFEROMETERY_DAYSEC) / RADIOINTERFEROMETERY_DAYSEC;
+	}
+}
+
+/*
+ * As `calc_modified_julian_dates_from_guppi_param`, with the Julian days
+ * starting at noon.
+ */
+void calc_julian_dates_from_guppi_param(
+	const double tbin,
+	const size_t sampleperblk,
+	const size_t piperblk,
+	const size_t synctime,
+	const size_t* pktidx,
+	size_t count,
+	double* jd_day,
+	double* jd_fraction
+) {
+	calc_modified_julian_dates_from_guppi_param(
+		tbin,
+		sampleperblk,
+		piperblk,
+		synctime,
+		pktidx,
+		count,
+		jd_day,
+		jd_fraction
+	);
+	for (size_t i = 0; i < count; i++) {
+		if (jd_fraction[i] < 0.5) {
+			jd_day[i] += 2400000.0;
+			jd_fraction[i] += 0.5;
+		}
+		else {
+			jd_day[i] += 2400001.0;
+			jd_fraction[i] -= 0.5;
+		}
+	}
+}
+
 void calc_independent_astrom(
 	double longitude_rad,
 	double latitude_rad,
@@ -27,10 +124,32 @@ void calc_independent_astrom(
 	double timemjd,
 	double dut1,
 	eraASTROM* astrom
+) {
+	calc_independent_astrom_with_two_part_date(
+		longitude_rad,
+		latitude_rad,
+		altitude,
+		timemjd, 0,
+		dut1,
+		astrom
+	);
+}
+
+/*
+ * The UTC date is `date1 + date2`, as for ERFA.
+ */
+void calc_independent_astrom_with_two_part_date(
+	double longitude_rad,
+	double latitude_rad,
+	double altitude,
+	double date1,
+	double date2,
+	double dut1,
+	eraASTROM* astrom
 ) {
 	double eo;
 	eraApco13(
-		timemjd, 0,
+		date1, date2,
 		dut1,
 		longitude_rad, latitude_rad, altitude,
 		0, 0,
@@ -40,6 +159,59 @@ void calc_independent_astrom(
 	);
 }
 
+void calc_astrom_cache_init(
+	calc_astrom_cache_t* cache,
+	double longitude_rad,
+	double latitude_rad,
+	double altitude,
+	double window_seconds
+) {
+	cache->longitude_rad = longitude_rad;
+	cache->latitude_rad = latitude_rad;
+	cache->altitude = altitude;
+	cache->window_days = window_seconds / RADIOINTERFEROMETERY_DAYSEC;
+	cache->anchor_timemjd = NAN;
+	cache->anchor_date2 = NAN;
+}
+
+eraASTROM* calc_astrom_cache_update(
+	calc_astrom_cache_t* cache,
+	double timemjd,
+	double dut1
+) {
+	return calc_astrom_cache_update_with_two_part_date(cache, timemjd, 0, dut1);
+}
+
+/*
+ * Within the window, only the Earth rotation angle is advanced (eraAper13),
+ * with UT1 as eraApco13 derives it.
+ */
+eraASTROM* calc_astrom_cache_update_with_two_part_date(
+	calc_astrom_cache_t* cache,
+	double date1,
+	double date2,
+	double dut1
+) {
+	double ut11, ut12;
+	if (fabs((date1 - cache->anchor_timemjd) + (date2 - cache->anchor_date2)) <= cache->window_days) {
+		eraUtcut1(date1, date2, dut1, &ut11, &ut12);
+		eraAper13(ut11, ut12, &cache->astrom);
+	}
+	else {
+		calc_independent_astrom_with_two_part_date(
+			cache->longitude_rad,
+			cache->latitude_rad,
+			cache->altitude,
+			date1, date2,
+			dut1,
+			&cache->astrom
+		);
+		cache->anchor_timemjd = date1;
+		cache->anchor_date2 = date2;
+	}
+	return &cache->astrom;
+}
+
 void calc_ha_dec_rad_with_independent_astrom(
 	double ra_rad,
 	double dec_rad,
@@ -63,6 +235,110 @@ void calc_ha_dec_rad_with_independent_astrom(
 	);
 }
 
+/*
+ * eraAtciq followed by eraAtioq (zero proper motion and parallax), fused per
+ * source: the CIRS vector is rotated by the Earth rotation angle directly
+ * instead of round-tripping through spherical coordinates.
+ * https://github.com/liberfa/erfa/blob/master/src/atciq.c
+ * https://github.com/liberfa/erfa/blob/master/src/atioq.c
+ */
+void calc_ha_dec_rad_batch_with_independent_astrom(
+	const double* ra_rad,
+	const double* dec_rad,
+	size_t count,
+	eraASTROM* astrom,
+	double* hour_angle_rad,
+	double* declination_rad
+) {
+	const double em2 = astrom->em*astrom->em;
+	const double dlim = 1e-6 / (em2 > 1.0 ? em2 : 1.0);
+	const double srs_em = ERFA_SRS / astrom->em;
+	const double cos_eral = cos(astrom->eral);
+	const double sin_eral = sin(astrom->eral);
+	const double* e = astrom->eh;
+	const double* v = astrom->v;
+
+	for (size_t i = 0; i < count; i++) {
+		double cos_dec = cos(dec_rad[i]);
+		double p[3] = {
+			cos(ra_rad[i])*cos_dec,
+			sin(ra_rad[i])*cos_dec,
+			sin(dec_rad[i])
+		};
+
+		// light deflection by the Sun (eraLdsun)
+		double qdqpe = p[0]*(p[0]+e[0]) + p[1]*(p[1]+e[1]) + p[2]*(p[2]+e[2]);
+		double w = srs_em / (qdqpe > dlim ? qdqpe : dlim);
+		double eq[3] = {
+			e[1]*p[2] - e[2]*p[1],
+			e[2]*p[0] - e[0]*p[2],
+			e[0]*p[1] - e[1]*p[0]
+		};
+		double pnat[3] = {
+			p[0] + w*(p[1]*eq[2] - p[2]*eq[1]),
+			p[1] + w*(p[2]*eq[0] - p[0]*eq[2]),
+			p[2] + w*(p[0]*eq[1] - p[1]*eq[0])
+		};
+
+		// aberration (eraAb)
+		double pdv = pnat[0]*v[0] + pnat[1]*v[1] + pnat[2]*v[2];
+		double w1 = 1.0 + pdv/(1.0 + astrom->bm1);
+		double ppr[3] = {
+			pnat[0]*astrom->bm1 + w1*v[0] + srs_em*(v[0] - pdv*pnat[0]),
+			pnat[1]*astrom->bm1 + w1*v[1] + srs_em*(v[1] - pdv*pnat[1]),
+			pnat[2]*astrom->bm1 + w1*v[2] + srs_em*(v[2] - pdv*pnat[2])
+		};
+		double r = sqrt(ppr[0]*ppr[0] + ppr[1]*ppr[1] + ppr[2]*ppr[2]);
+
+		// bias-precession-nutation, to CIRS
+		double pi[3] = {
+			(astrom->bpn[0][0]*ppr[0] + astrom->bpn[0][1]*ppr[1] + astrom->bpn[0][2]*ppr[2])/r,
+			(astrom->bpn[1][0]*ppr[0] + astrom->bpn[1][1]*ppr[1] + astrom->bpn[1][2]*ppr[2])/r,
+			(astrom->bpn[2][0]*ppr[0] + astrom->bpn[2][1]*ppr[1] + astrom->bpn[2][2]*ppr[2])/r
+		};
+
+		// Earth rotation angle, to Cartesian -HA,Dec
+		double x = cos_eral*pi[0] + sin_eral*pi[1];
+		double y = cos_eral*pi[1] - sin_eral*pi[0];
+		double z = pi[2];
+
+		// polar motion
+		double xhd = x + astrom->xpl*z;
+		double yhd = y - astrom->ypl*z;
+		double zhd = z - astrom->xpl*x + astrom->ypl*y;
+
+		// diurnal aberration
+		double f = 1.0 - astrom->diurab*yhd;
+		double xhdt = f*xhd;
+		double yhdt = f*(yhd + astrom->diurab);
+		double zhdt = f*zhd;
+
+		// to Cartesian Az,El (S=0,E=90) and refraction
+		double xaet = astrom->sphi*xhdt - astrom->cphi*zhdt;
+		double yaet = yhdt;
+		double zaet = astrom->cphi*xhdt + astrom->sphi*zhdt;
+		r = sqrt(xaet*xaet + yaet*yaet);
+		r = r > 1e-6 ? r : 1e-6;
+		z = zaet > 0.05 ? zaet : 0.05;
+		double tz = r/z;
+		w = astrom->refb*tz*tz;
+		double del = (astrom->refa + w)*tz / (1.0 + (astrom->refa + 3.0*w)/(z*z));
+		double cosdel = 1.0 - del*del/2.0;
+		f = cosdel - del*z/r;
+		double xaeo = xaet*f;
+		double yaeo = yaet*f;
+		double zaeo = cosdel*zaet + del*r;
+
+		// back to Cartesian -HA,Dec
+		x = astrom->sphi*xaeo + astrom->cphi*zaeo;
+		y = yaeo;
+		z = -astrom->cphi*xaeo + astrom->sphi*zaeo;
+
+		hour_angle_rad[i] = (x != 0.0 || y != 0.0) ? -atan2(y, x) : 0.0;
+		declination_rad[i] = (z != 0.0) ? atan2(z, sqrt(x*x + y*y)) : 0.0;
+	}
+}
+
 void calc_ha_dec_rad(
 	double ra_rad,
 	double dec_rad,
@@ -73,12 +349,40 @@ void calc_ha_dec_rad(
 	double dut1,
 	double* hour_angle_rad,
 	double* declination_rad
+) {
+	calc_ha_dec_rad_with_two_part_date(
+		ra_rad,
+		dec_rad,
+		longitude_rad,
+		latitude_rad,
+		altitude,
+		timemjd, 0,
+		dut1,
+		hour_angle_rad,
+		declination_rad
+	);
+}
+
+/*
+ * The UTC date is `date1 + date2`, as for ERFA.
+ */
+void calc_ha_dec_rad_with_two_part_date(
+	double ra_rad,
+	double dec_rad,
+	double longitude_rad,
+	double latitude_rad,
+	double altitude,
+	double date1,
+	double date2,
+	double dut1,
+	double* hour_angle_rad,
+	double* declination_rad
 ) {
 	double aob, zob, rob, eo;
 	eraAtco13(
 		ra_rad, dec_rad,
 		0, 0, 0, 0,
-		timemjd, 0,
+		date1, date2,
 		dut1,
 		longitude_rad, latitude_rad, altitude,
 		0, 0,
@@ -153,16 +457,14 @@ void calc_ecef_from_lla(
  * y' = cos*vec.y + sin*vec.z
  * z' = -sin*vec.y + cos*vec.z
  */
-static inline void _rotate_around_x_cached_trig(
-	double vec[3],
+static inline void _rotation_around_x_cached_trig(
+	double rotation[3][3],
 	double sin_val,
 	double cos_val
 ) {
-	double y, z;
-	y = vec[1];
-	z = vec[2];
-	vec[1] = cos_val*y - sin_val*z;
-	vec[2] = sin_val*y + cos_val*z;
+	rotation[0][0] = 1.0; rotation[0][1] = 0.0;     rotation[0][2] = 0.0;
+	rotation[1][0] = 0.0; rotation[1][1] = cos_val; rotation[1][2] = -sin_val;
+	rotation[2][0] = 0.0; rotation[2][1] = sin_val; rotation[2][2] = cos_val;
 }
 
 /*
@@ -170,16 +472,14 @@ static inline void _rotate_around_x_cached_trig(
  * x' = cos*vec.x - sin*vec.z
  * z' = sin*vec.x + cos*vec.z
  */
-static inline void _rotate_around_y_cached_trig(
-	double vec[3],
+static inline void _rotation_around_y_cached_trig(
+	double rotation[3][3],
 	double sin_val,
 	double cos_val
 ) {
-	double x, z;
-	x = vec[0];
-	z = vec[2];
-	vec[0] = cos_val*x + sin_val*z;
-	vec[2] = -sin_val*x + cos_val*z;
+	rotation[0][0] = cos_val;  rotation[0][1] = 0.0; rotation[0][2] = sin_val;
+	rotation[1][0] = 0.0;      rotation[1][1] = 1.0; rotation[1][2] = 0.0;
+	rotation[2][0] = -sin_val; rotation[2][1] = 0.0; rotation[2][2] = cos_val;
 }
 
 /*
@@ -187,32 +487,55 @@ static inline void _rotate_around_y_cached_trig(
  * x' = cos*vec.x - sin*vec.y
  * y' = sin*vec.x + cos*vec.y
  */
-static inline void _rotate_around_z_cached_trig(
-	double vec[3],
+static inline void _rotation_around_z_cached_trig(
+	double rotation[3][3],
 	double sin_val,
 	double cos_val
 ) {
-	double x, y;
-	x = vec[0];
-	y = vec[1];
-	vec[0] = cos_val*x - sin_val*y;
-	vec[1] = sin_val*x + cos_val*y;
+	rotation[0][0] = cos_val; rotation[0][1] = -sin_val; rotation[0][2] = 0.0;
+	rotation[1][0] = sin_val; rotation[1][1] = cos_val;  rotation[1][2] = 0.0;
+	rotation[2][0] = 0.0;     rotation[2][1] = 0.0;      rotation[2][2] = 1.0;
 }
 
 /*
- * Subtracts ECEF(LLA, WGS84) from positions.
+ * rotation = first followed by second, i.e. second x first.
  */
-void calc_position_to_xyz_frame_from_ecef(
-	double* positions,
-	int position_count,
+static inline void _rotation_then(
+	double rotation[3][3],
+	const double first[3][3],
+	const double second[3][3]
+) {
+	double product[3][3];
+	for (int r = 0; r < 3; r++) {
+		for (int c = 0; c < 3; c++) {
+			product[r][c] = second[r][0]*first[0][c] + second[r][1]*first[1][c] + second[r][2]*first[2][c];
+		}
+	}
+	memcpy(rotation, product, sizeof(product));
+}
+
+/*
+ * Cyclically permutes the rows such that row `r` becomes row `r+shift`.
+ */
+static inline void _rotation_permute_rows(
+	double rotation[3][3],
+	int shift
+) {
+	double permuted[3][3];
+	for (int r = 0; r < 3; r++) {
+		memcpy(permuted[(r+shift)%3], rotation[r], sizeof(permuted[0]));
+	}
+	memcpy(rotation, permuted, sizeof(permuted));
+}
+
+static void _ecef_from_lla_wgs84(
+	double ecef[3],
 	double longitude_rad,
 	double latitude_rad,
 	double altitude
 ) {
-	double ecef[3];
 	geodesy_t wgs84 = {0};
 	geodesy_from_af_inv(&wgs84, WGS84_A_METERS, WGS84_F_INV);
-
 	calc_ecef_from_lla(
 		ecef,
 		longitude_rad,
@@ -220,34 +543,83 @@ void calc_position_to_xyz_frame_from_ecef(
 		altitude,
 		&wgs84
 	);
-	ecef[0] *= -1.0;
-	ecef[1] *= -1.0;
-	ecef[2] *= -1.0;
-	calc_frame_translate(positions, position_count, ecef);
+}
+
+void calc_frame_transform_identity(calc_frame_transform_t* transform) {
+	memset(transform, 0, sizeof(calc_frame_transform_t));
+	transform->rotation[0][0] = 1.0;
+	transform->rotation[1][1] = 1.0;
+	transform->rotation[2][2] = 1.0;
 }
 
 /*
- * Adds ECEF(LLA, WGS84) to positions.
+ * second(first(p)) = R2*(R1*(p + a1) + b1 + a2) + b2
+ *                  = R2*R1*(p + a1) + R2*(b1 + a2) + b2
  */
-void calc_position_to_ecef_frame_from_xyz(
+void calc_frame_transform_compose(
+	calc_frame_transform_t* transform,
+	const calc_frame_transform_t* first,
+	const calc_frame_transform_t* second
+) {
+	calc_frame_transform_t composed;
+	double between[3];
+	for (int r = 0; r < 3; r++) {
+		composed.pre_translation[r] = first->pre_translation[r];
+		between[r] = first->post_translation[r] + second->pre_translation[r];
+	}
+	_rotation_then(composed.rotation, first->rotation, second->rotation);
+	for (int r = 0; r < 3; r++) {
+		composed.post_translation[r] =
+			second->rotation[r][0]*between[0]
+			+ second->rotation[r][1]*between[1]
+			+ second->rotation[r][2]*between[2]
+			+ second->post_translation[r]
+		;
+	}
+	memcpy(transform, &composed, sizeof(composed));
+}
+
+void calc_frame_transform_apply(
+	const calc_frame_transform_t* transform,
 	double* positions,
-	int position_count,
+	int position_count
+) {
+	calc_positions_transform(
+		positions,
+		position_count,
+		transform->pre_translation,
+		transform->rotation,
+		transform->post_translation
+	);
+}
+
+/*
+ * Subtracts ECEF(LLA, WGS84) from positions.
+ */
+void calc_frame_transform_to_xyz_from_ecef(
+	calc_frame_transform_t* transform,
 	double longitude_rad,
 	double latitude_rad,
 	double altitude
 ) {
-	double ecef[3];
-	geodesy_t wgs84 = {0};
-	geodesy_from_af_inv(&wgs84, WGS84_A_METERS, WGS84_F_INV);
+	calc_frame_transform_identity(transform);
+	_ecef_from_lla_wgs84(transform->pre_translation, longitude_rad, latitude_rad, altitude);
+	transform->pre_translation[0] *= -1.0;
+	transform->pre_translation[1] *= -1.0;
+	transform->pre_translation[2] *= -1.0;
+}
 
-	calc_ecef_from_lla(
-		ecef,
-		longitude_rad,
-		latitude_rad,
-		altitude,
-		&wgs84
-	);
-	calc_frame_translate(positions, position_count, ecef);
+/*
+ * Adds ECEF(LLA, WGS84) to positions.
+ */
+void calc_frame_transform_to_ecef_from_xyz(
+	calc_frame_transform_t* transform,
+	double longitude_rad,
+	double latitude_rad,
+	double altitude
+) {
+	calc_frame_transform_identity(transform);
+	_ecef_from_lla_wgs84(transform->post_translation, longitude_rad, latitude_rad, altitude);
 }
 
 /*
@@ -257,38 +629,21 @@ void calc_position_to_ecef_frame_from_xyz(
  * anticlockwise about the Z (i.e. second) axis by `-lon_rad`, producing a
  * (Y,Z,X) frame which is then permuted to (X,Y,Z).
  */
-void calc_position_to_xyz_frame_from_enu(
-	double* positions,
-	int position_count,
+void calc_frame_transform_to_xyz_from_enu(
+	calc_frame_transform_t* transform,
 	double longitude_rad,
 	double latitude_rad,
 	double altitude // Not used
 ) {
-	double sin_longitude = sin(longitude_rad);
-	double cos_longitude = cos(longitude_rad);
-	double sin_latitude = sin(latitude_rad);
-	double cos_latitude = cos(latitude_rad);
-	double tmp;
-	while(--position_count >= 0)
-	{
-		// RotX(longitude) anti-clockwise
-		_rotate_around_x_cached_trig(
-			positions + position_count*3,
-			-sin_latitude,
-			cos_latitude
-		);
-		// RotY(longitude) clockwise
-		_rotate_around_y_cached_trig(
-			positions + position_count*3,
-			sin_longitude,
-			cos_longitude
-		);
-		// Permute (YZX) to (XYZ)
-		tmp = positions[position_count*3 + 2]; // save X
-		positions[position_count*3 + 2] = positions[position_count*3 + 1]; // move Z
-		positions[position_count*3 + 1] = positions[position_count*3 + 0]; // move Y
-		positions[position_count*3 + 0] = tmp; // move X
-	}
+	double step[3][3];
+	calc_frame_transform_identity(transform);
+	// RotX(longitude) anti-clockwise
+	_rotation_around_x_cached_trig(transform->rotation, -sin(latitude_rad), cos(latitude_rad));
+	// RotY(longitude) clockwise
+	_rotation_around_y_cached_trig(step, sin(longitude_rad), cos(longitude_rad));
+	_rotation_then(transform->rotation, transform->rotation, step);
+	// Permute (YZX) to (XYZ)
+	_rotation_permute_rows(transform->rotation, 1);
 }
 
 /*
@@ -298,90 +653,51 @@ void calc_position_to_xyz_frame_from_enu(
  * anticlockwise about the E (i.e. second) axis by `-lat_rad`, producing a
  * (U,E,N) frame which is then permuted to (E,N,U).
  */
-void calc_position_to_enu_frame_from_xyz(
-	double* positions,
-	int position_count,
+void calc_frame_transform_to_enu_from_xyz(
+	calc_frame_transform_t* transform,
 	double longitude_rad,
 	double latitude_rad,
 	double altitude // Not used
 ) {
-	double sin_longitude = sin(longitude_rad);
-	double cos_longitude = cos(longitude_rad);
-	double sin_latitude = sin(latitude_rad);
-	double cos_latitude = cos(latitude_rad);
-	double tmp;
-	while(--position_count >= 0)
-	{
-		// RotZ(longitude) anti-clockwise
-		_rotate_around_z_cached_trig(
-			positions + position_count*3,
-			-sin_longitude,
-			cos_longitude
-		);
-		// RotY(longitude) clockwise
-		_rotate_around_y_cached_trig(
-			positions + position_count*3,
-			sin_latitude,
-			cos_latitude
-		);
-		// Permute (UEN) to (ENU)
-		tmp = positions[position_count*3 + 0];
-		positions[position_count*3 + 0] = positions[position_count*3 + 1];
-		positions[position_count*3 + 1] = positions[position_count*3 + 2];
-		positions[position_count*3 + 2] = tmp;
-	}
+	double step[3][3];
+	calc_frame_transform_identity(transform);
+	// RotZ(longitude) anti-clockwise
+	_rotation_around_z_cached_trig(transform->rotation, -sin(longitude_rad), cos(longitude_rad));
+	// RotY(longitude) clockwise
+	_rotation_around_y_cached_trig(step, sin(latitude_rad), cos(latitude_rad));
+	_rotation_then(transform->rotation, transform->rotation, step);
+	// Permute (UEN) to (ENU)
+	_rotation_permute_rows(transform->rotation, 2);
 }
 
 /*
  * Effects `ecef -> xyz -> enu`.
  */
-void calc_position_to_enu_frame_from_ecef(
-	double* positions,
-	int position_count,
+void calc_frame_transform_to_enu_from_ecef(
+	calc_frame_transform_t* transform,
 	double longitude_rad,
 	double latitude_rad,
 	double altitude
 ) {
-	calc_position_to_xyz_frame_from_ecef(
-		positions,
-		position_count,
-		longitude_rad,
-		latitude_rad,
-		altitude
-	);
-	calc_position_to_enu_frame_from_xyz(
-		positions,
-		position_count,
-		longitude_rad,
-		latitude_rad,
-		altitude
-	);
+	calc_frame_transform_t xyz_from_ecef, enu_from_xyz;
+	calc_frame_transform_to_xyz_from_ecef(&xyz_from_ecef, longitude_rad, latitude_rad, altitude);
+	calc_frame_transform_to_enu_from_xyz(&enu_from_xyz, longitude_rad, latitude_rad, altitude);
+	calc_frame_transform_compose(transform, &xyz_from_ecef, &enu_from_xyz);
 }
 
 /*
  * Effects `enu -> xyz -> ecef`.
  */
-void calc_position_to_ecef_frame_from_enu(
-	double* positions,
-	int position_count,
+void calc_frame_transform_to_ecef_from_enu(
+	calc_frame_transform_t* transform,
 	double longitude_rad,
 	double latitude_rad,
 	double altitude
 ) {
-	calc_position_to_xyz_frame_from_enu(
-		positions,
-		position_count,
-		longitude_rad,
-		latitude_rad,
-		altitude
-	);
-	calc_position_to_ecef_frame_from_xyz(
-		positions,
-		position_count,
-		longitude_rad,
-		latitude_rad,
-		altitude
-	);
+	calc_frame_transform_t xyz_from_enu, ecef_from_xyz;
+	calc_frame_transform_to_xyz_from_enu(&xyz_from_enu, longitude_rad, latitude_rad, altitude);
+	calc_frame_transform_to_ecef_from_xyz(&ecef_from_xyz, longitude_rad, latitude_rad, altitude);
+	calc_frame_transform_compose(transform, &xyz_from_enu, &ecef_from_xyz);
 }
 
 /*
@@ -393,40 +709,22 @@ void calc_position_to_ecef_frame_from_enu(
  * `-dec_rad`, producing the (U,V,W) frame where U is east, V is north, and W is
  * in the direction of projection.
  */
-void calc_position_to_uvw_frame_from_enu(
-	double* positions,
-	int position_count,
+void calc_frame_transform_to_uvw_from_enu(
+	calc_frame_transform_t* transform,
 	double hour_angle_rad,
 	double declination_rad,
 	double latitude_rad
 ) {
-	double sin_hour_angle = sin(hour_angle_rad);
-	double cos_hour_angle = cos(hour_angle_rad);
-	double sin_declination = sin(declination_rad);
-	double cos_declination = cos(declination_rad);
-	double sin_latitude = sin(latitude_rad);
-	double cos_latitude = cos(latitude_rad);
-
-	while(--position_count >= 0) {
-		 // anti-clockwise
-		_rotate_around_x_cached_trig(
-			positions + position_count*3,
-			-sin_latitude,
-			cos_latitude
-		);
-		 // clockwise
-		_rotate_around_y_cached_trig(
-			positions + position_count*3,
-			sin_hour_angle,
-			cos_hour_angle
-		);
-		 // clockwise
-		_rotate_around_x_cached_trig(
-			positions + position_count*3,
-			sin_declination,
-			cos_declination
-		);
-	}
+	double step[3][3];
+	calc_frame_transform_identity(transform);
+	// anti-clockwise
+	_rotation_around_x_cached_trig(transform->rotation, -sin(latitude_rad), cos(latitude_rad));
+	// clockwise
+	_rotation_around_y_cached_trig(step, sin(hour_angle_rad), cos(hour_angle_rad));
+	_rotation_then(transform->rotation, transform->rotation, step);
+	// clockwise
+	_rotation_around_x_cached_trig(step, sin(declination_rad), cos(declination_rad));
+	_rotation_then(transform->rotation, transform->rotation, step);
 }
 
 /*
@@ -438,6 +736,131 @@ void calc_position_to_uvw_frame_from_enu(
  * and W is in the direction of the given hour angle and declination as seen from
  * the given longitude.
  */
+void calc_frame_transform_to_uvw_from_xyz(
+	calc_frame_transform_t* transform,
+	double hour_angle_rad,
+	double declination_rad,
+	double longitude_rad
+) {
+	double step[3][3];
+	calc_frame_transform_identity(transform);
+	// RotZ(long-ha) anti-clockwise
+	_rotation_around_z_cached_trig(transform->rotation, -sin(longitude_rad-hour_angle_rad), cos(longitude_rad-hour_angle_rad));
+	// RotY(declination) clockwise
+	_rotation_around_y_cached_trig(step, sin(declination_rad), cos(declination_rad));
+	_rotation_then(transform->rotation, transform->rotation, step);
+	// Permute (WUV) to (UVW)
+	_rotation_permute_rows(transform->rotation, 2);
+}
+
+/*
+ * Applies `calc_frame_transform_to_xyz_from_ecef`.
+ */
+void calc_position_to_xyz_frame_from_ecef(
+	double* positions,
+	int position_count,
+	double longitude_rad,
+	double latitude_rad,
+	double altitude
+) {
+	calc_frame_transform_t transform;
+	calc_frame_transform_to_xyz_from_ecef(&transform, longitude_rad, latitude_rad, altitude);
+	calc_frame_transform_apply(&transform, positions, position_count);
+}
+
+/*
+ * Applies `calc_frame_transform_to_ecef_from_xyz`.
+ */
+void calc_position_to_ecef_frame_from_xyz(
+	double* positions,
+	int position_count,
+	double longitude_rad,
+	double latitude_rad,
+	double altitude
+) {
+	calc_frame_transform_t transform;
+	calc_frame_transform_to_ecef_from_xyz(&transform, longitude_rad, latitude_rad, altitude);
+	calc_frame_transform_apply(&transform, positions, position_count);
+}
+
+/*
+ * Applies `calc_frame_transform_to_xyz_from_enu`.
+ */
+void calc_position_to_xyz_frame_from_enu(
+	double* positions,
+	int position_count,
+	double longitude_rad,
+	double latitude_rad,
+	double altitude // Not used
+) {
+	calc_frame_transform_t transform;
+	calc_frame_transform_to_xyz_from_enu(&transform, longitude_rad, latitude_rad, altitude);
+	calc_frame_transform_apply(&transform, positions, position_count);
+}
+
+/*
+ * Applies `calc_frame_transform_to_enu_from_xyz`.
+ */
+void calc_position_to_enu_frame_from_xyz(
+	double* positions,
+	int position_count,
+	double longitude_rad,
+	double latitude_rad,
+	double altitude // Not used
+) {
+	calc_frame_transform_t transform;
+	calc_frame_transform_to_enu_from_xyz(&transform, longitude_rad, latitude_rad, altitude);
+	calc_frame_transform_apply(&transform, positions, position_count);
+}
+
+/*
+ * Applies `calc_frame_transform_to_enu_from_ecef`.
+ */
+void calc_position_to_enu_frame_from_ecef(
+	double* positions,
+	int position_count,
+	double longitude_rad,
+	double latitude_rad,
+	double altitude
+) {
+	calc_frame_transform_t transform;
+	calc_frame_transform_to_enu_from_ecef(&transform, longitude_rad, latitude_rad, altitude);
+	calc_frame_transform_apply(&transform, positions, position_count);
+}
+
+/*
+ * Applies `calc_frame_transform_to_ecef_from_enu`.
+ */
+void calc_position_to_ecef_frame_from_enu(
+	double* positions,
+	int position_count,
+	double longitude_rad,
+	double latitude_rad,
+	double altitude
+) {
+	calc_frame_transform_t transform;
+	calc_frame_transform_to_ecef_from_enu(&transform, longitude_rad, latitude_rad, altitude);
+	calc_frame_transform_apply(&transform, positions, position_count);
+}
+
+/*
+ * Applies `calc_frame_transform_to_uvw_from_enu`.
+ */
+void calc_position_to_uvw_frame_from_enu(
+	double* positions,
+	int position_count,
+	double hour_angle_rad,
+	double declination_rad,
+	double latitude_rad
+) {
+	calc_frame_transform_t transform;
+	calc_frame_transform_to_uvw_from_enu(&transform, hour_angle_rad, declination_rad, latitude_rad);
+	calc_frame_transform_apply(&transform, positions, position_count);
+}
+
+/*
+ * Applies `calc_frame_transform_to_uvw_from_xyz`.
+ */
 void calc_position_to_uvw_frame_from_xyz(
 	double* positions,
 	int position_count,
@@ -445,31 +868,9 @@ void calc_position_to_uvw_frame_from_xyz(
 	double declination_rad,
 	double longitude_rad
 ) {
-	double sin_long_minus_hangle = sin(longitude_rad-hour_angle_rad);
-	double cos_long_minus_hangle = cos(longitude_rad-hour_angle_rad);
-	double sin_declination = sin(declination_rad);
-	double cos_declination = cos(declination_rad);
-	double tmp;
-
-	while (--position_count >= 0) {
-		// RotZ(long-ha) anti-clockwise
-		_rotate_around_z_cached_trig(
-			positions + 3*position_count,
-			-sin_long_minus_hangle,
-			cos_long_minus_hangle
-		);
-		// RotY(declination) clockwise
-		_rotate_around_y_cached_trig(
-			positions + 3*position_count,
-			sin_declination,
-			cos_declination
-		);
-		// Permute (WUV) to (UVW)
-		tmp = positions[3*position_count + 0]; // save W
-		positions[3*position_count + 0] = positions[3*position_count + 1]; // move U
-		positions[3*position_count + 1] = positions[3*position_count + 2]; // move U
-		positions[3*position_count + 2] = tmp; // move U
-	}
+	calc_frame_transform_t transform;
+	calc_frame_transform_to_uvw_from_xyz(&transform, hour_angle_rad, declination_rad, longitude_rad);
+	calc_frame_transform_apply(&transform, positions, position_count);
 }
 
 /*
@@ -501,3 +902,309 @@ void calc_position_delays(
 		;
 	}
 }
+
+/*
+ * As `calc_position_delays`, also producing the delays' rates and
+ * accelerations, analytically from the derivative of the W coordinate with
+ * respect to the hour angle. The hour angle is taken to advance at the
+ * Earth's rotation rate, that is the source's apparent position is taken to
+ * be fixed. With `theta = longitude - hour_angle`:
+ *   W = cos(dec)*(cos(theta)*x + sin(theta)*y) + sin(dec)*z
+ *   dW/dt = -rate * cos(dec)*U
+ *   d2W/dt2 = -rate^2 * cos(dec)*(cos(theta)*x + sin(theta)*y)
+ *
+ * `positions_xyz_in_uvw_out` must be populated with `xyz` positions.
+ * Its contents will be overwritten with `uvw` positions.
+ */
+void calc_position_delays_with_rates(
+	double* positions_xyz_in_uvw_out,
+	int position_count,
+	int reference_position_index,
+	double hour_angle_rad,
+	double declination_rad,
+	double longitude_rad,
+	double* delays,
+	double* delay_rates,
+	double* delay_accelerations
+) {
+	const double sin_long_minus_hangle = sin(longitude_rad-hour_angle_rad);
+	const double cos_long_minus_hangle = cos(longitude_rad-hour_angle_rad);
+	const double sin_declination = sin(declination_rad);
+	const double cos_declination = cos(declination_rad);
+	const double rate = RADIOINTERFEROMETERY_EARTH_ROTATION_RATE;
+	double* position;
+	double x, y, z, xy;
+
+	for (int i = 0; i < position_count; i++) {
+		position = positions_xyz_in_uvw_out + 3*i;
+		x = position[0];
+		y = position[1];
+		z = position[2];
+		xy = cos_long_minus_hangle*x + sin_long_minus_hangle*y;
+		position[0] = cos_long_minus_hangle*y - sin_long_minus_hangle*x;
+		position[1] = cos_declination*z - sin_declination*xy;
+		position[2] = cos_declination*xy + sin_declination*z;
+		// the W acceleration, for now
+		delay_accelerations[i] = -rate*rate*cos_declination*xy;
+	}
+
+	const double reference_w = positions_xyz_in_uvw_out[reference_position_index*3 + 2];
+	const double reference_u = positions_xyz_in_uvw_out[reference_position_index*3 + 0];
+	const double reference_w_acceleration = delay_accelerations[reference_position_index];
+	for (int i = 0; i < position_count; i++) {
+		delays[i] = (positions_xyz_in_uvw_out[i*3 + 2] - reference_w) / RADIOINTERFEROMETERY_C;
+		delay_rates[i] = -rate*cos_declination*(positions_xyz_in_uvw_out[i*3 + 0] - reference_u) / RADIOINTERFEROMETERY_C;
+		delay_accelerations[i] = (delay_accelerations[i] - reference_w_acceleration) / RADIOINTERFEROMETERY_C;
+	}
+}
+
+/*
+ * The delay of a position relative to the reference is
+ * `(W - W_ref)/C = a*(x - x_ref) + b*(y - y_ref) + g*(z - z_ref)` with
+ * `a = cos(dec)*cos(theta)/C`, `b = cos(dec)*sin(theta)/C`, `g = sin(dec)/C`
+ * and `theta = longitude - hour_angle` (see `calc_position_to_uvw_frame_from_xyz`).
+ */
+static void _delay_matrix_beam_coefficients(
+	const double* hour_angle_rad,
+	const double* declination_rad,
+	int beam_count,
+	double longitude_rad,
+	double* coefficients
+) {
+	double cos_declination;
+	for (int b = 0; b < beam_count; b++) {
+		cos_declination = cos(declination_rad[b]);
+		coefficients[3*b + 0] = cos_declination*cos(longitude_rad-hour_angle_rad[b]) / RADIOINTERFEROMETERY_C;
+		coefficients[3*b + 1] = cos_declination*sin(longitude_rad-hour_angle_rad[b]) / RADIOINTERFEROMETERY_C;
+		coefficients[3*b + 2] = sin(declination_rad[b]) / RADIOINTERFEROMETERY_C;
+	}
+}
+
+/*
+ * The delay matrix of the beams with the given coefficients (per
+ * `_delay_matrix_beam_coefficients`). Positions are processed in blocks of
+ * CALC_DELAY_MATRIX_BLOCK_POSITIONS across all beams, so that each block stays
+ * in L1 cache.
+ */
+static void _delay_matrix_from_coefficients(
+	const double* positions_xyz,
+	int position_count,
+	int reference_position_index,
+	const double* coefficients,
+	int beam_count,
+	double* delays
+) {
+	const double* reference = positions_xyz + 3*reference_position_index;
+	const double* coefficient;
+	double* beam_delays;
+	int block_end;
+
+	for (int block = 0; block < position_count; block += CALC_DELAY_MATRIX_BLOCK_POSITIONS) {
+		block_end = block + CALC_DELAY_MATRIX_BLOCK_POSITIONS < position_count ? block + CALC_DELAY_MATRIX_BLOCK_POSITIONS : position_count;
+		for (int b = 0; b < beam_count; b++) {
+			coefficient = coefficients + 3*b;
+			beam_delays = delays + (size_t)b*position_count;
+			for (int i = block; i < block_end; i++) {
+				beam_delays[i] =
+					coefficient[0]*(positions_xyz[3*i + 0] - reference[0])
+					+ coefficient[1]*(positions_xyz[3*i + 1] - reference[1])
+					+ coefficient[2]*(positions_xyz[3*i + 2] - reference[2])
+				;
+			}
+		}
+	}
+}
+
+static void _delay_matrix_from_coefficients_f(
+	const double* positions_xyz,
+	int position_count,
+	int reference_position_index,
+	const double* coefficients,
+	int beam_count,
+	float* delays
+) {
+	const double* reference = positions_xyz + 3*reference_position_index;
+	const double* coefficient;
+	float* beam_delays;
+	int block_end;
+
+	for (int block = 0; block < position_count; block += CALC_DELAY_MATRIX_BLOCK_POSITIONS) {
+		block_end = block + CALC_DELAY_MATRIX_BLOCK_POSITIONS < position_count ? block + CALC_DELAY_MATRIX_BLOCK_POSITIONS : position_count;
+		for (int b = 0; b < beam_count; b++) {
+			coefficient = coefficients + 3*b;
+			beam_delays = delays + (size_t)b*position_count;
+			for (int i = block; i < block_end; i++) {
+				beam_delays[i] = (float) (
+					coefficient[0]*(positions_xyz[3*i + 0] - reference[0])
+					+ coefficient[1]*(positions_xyz[3*i + 1] - reference[1])
+					+ coefficient[2]*(positions_xyz[3*i + 2] - reference[2])
+				);
+			}
+		}
+	}
+}
+
+/*
+ * The delays of each position for each beam, relative to the reference
+ * position, in `delays[beam*position_count + position]`. Unlike
+ * `calc_position_delays`, `positions_xyz` is left intact. The beams are taken
+ * CALC_DELAY_MATRIX_BLOCK_BEAMS at a time, their coefficients on the stack, so
+ * that no heap allocation is made.
+ */
+void calc_delay_matrix(
+	const double* positions_xyz,
+	int position_count,
+	int reference_position_index,
+	const double* hour_angle_rad,
+	const double* declination_rad,
+	int beam_count,
+	double longitude_rad,
+	double* delays
+) {
+	double coefficients[3*CALC_DELAY_MATRIX_BLOCK_BEAMS];
+	int block_beam_count;
+
+	for (int beam_block = 0; beam_block < beam_count; beam_block += CALC_DELAY_MATRIX_BLOCK_BEAMS) {
+		block_beam_count = beam_count - beam_block < CALC_DELAY_MATRIX_BLOCK_BEAMS ? beam_count - beam_block : CALC_DELAY_MATRIX_BLOCK_BEAMS;
+		_delay_matrix_beam_coefficients(hour_angle_rad + beam_block, declination_rad + beam_block, block_beam_count, longitude_rad, coefficients);
+		_delay_matrix_from_coefficients(
+			positions_xyz,
+			position_count,
+			reference_position_index,
+			coefficients,
+			block_beam_count,
+			delays + (size_t)beam_block*position_count
+		);
+	}
+}
+
+void calc_delay_matrix_f(
+	const double* positions_xyz,
+	int position_count,
+	int reference_position_index,
+	const double* hour_angle_rad,
+	const double* declination_rad,
+	int beam_count,
+	double longitude_rad,
+	float* delays
+) {
+	double coefficients[3*CALC_DELAY_MATRIX_BLOCK_BEAMS];
+	int block_beam_count;
+
+	for (int beam_block = 0; beam_block < beam_count; beam_block += CALC_DELAY_MATRIX_BLOCK_BEAMS) {
+		block_beam_count = beam_count - beam_block < CALC_DELAY_MATRIX_BLOCK_BEAMS ? beam_count - beam_block : CALC_DELAY_MATRIX_BLOCK_BEAMS;
+		_delay_matrix_beam_coefficients(hour_angle_rad + beam_block, declination_rad + beam_block, block_beam_count, longitude_rad, coefficients);
+		_delay_matrix_from_coefficients_f(
+			positions_xyz,
+			position_count,
+			reference_position_index,
+			coefficients,
+			block_beam_count,
+			delays + (size_t)beam_block*position_count
+		);
+	}
+}
+
+/*
+ * As `calc_delay_matrix`, with the coefficients of all beams computed at once
+ * into `coefficients`, caller-owned scratch of `3*beam_count` doubles, so that
+ * each block of positions is shared by all beams.
+ */
+void calc_delay_matrix_workspace(
+	const double* positions_xyz,
+	int position_count,
+	int reference_position_index,
+	const double* hour_angle_rad,
+	const double* declination_rad,
+	int beam_count,
+	double longitude_rad,
+	double* coefficients,
+	double* delays
+) {
+	_delay_matrix_beam_coefficients(hour_angle_rad, declination_rad, beam_count, longitude_rad, coefficients);
+	_delay_matrix_from_coefficients(
+		positions_xyz,
+		position_count,
+		reference_position_index,
+		coefficients,
+		beam_count,
+		delays
+	);
+}
+
+/*
+ * Single precision positions relative to `centre`, the subtraction being done
+ * in double precision. With `centre` the array centre (e.g. the ECEF of the
+ * site, per `calc_ecef_from_lla`), the magnitudes shrink from the Earth's
+ * radius to the array's extent, so that single precision resolves
+ * `2^-24 * extent`: 0.06 mm for 1 km.
+ */
+void calc_positions_relative_f(
+	const double* positions,
+	int position_count,
+	const double centre[3],
+	float* positions_relative
+) {
+	for (int i = 0; i < position_count; i++) {
+		positions_relative[3*i + 0] = (float) (positions[3*i + 0] - centre[0]);
+		positions_relative[3*i + 1] = (float) (positions[3*i + 1] - centre[1]);
+		positions_relative[3*i + 2] = (float) (positions[3*i + 2] - centre[2]);
+	}
+}
+
+/*
+ * As `calc_frame_transform_apply` in single precision, for transforms between
+ * array-centred frames (XYZ, ENU, UVW), not those translating by the ECEF of
+ * the site, which single precision cannot hold to better than 0.5 m.
+ */
+void calc_frame_transform_apply_f(
+	const calc_frame_transform_t* transform,
+	float* positions,
+	int position_count
+) {
+	float a[3], r[3][3], b[3];
+	float x, y, z;
+	for (int i = 0; i < 3; i++) {
+		a[i] = (float) transform->pre_translation[i];
+		b[i] = (float) transform->post_translation[i];
+		for (int j = 0; j < 3; j++) {
+			r[i][j] = (float) transform->rotation[i][j];
+		}
+	}
+	for (int i = 0; i < position_count; i++) {
+		x = positions[3*i + 0] + a[0];
+		y = positions[3*i + 1] + a[1];
+		z = positions[3*i + 2] + a[2];
+		positions[3*i + 0] = r[0][0]*x + r[0][1]*y + r[0][2]*z + b[0];
+		positions[3*i + 1] = r[1][0]*x + r[1][1]*y + r[1][2]*z + b[1];
+		positions[3*i + 2] = r[2][0]*x + r[2][1]*y + r[2][2]*z + b[2];
+	}
+}
+
+/*
+ * As `calc_position_delays` in single precision, for array-centred `xyz`
+ * positions (see `calc_positions_relative_f`). Each W coordinate is within a
+ * few single precision roundings of the position's distance R from the array
+ * centre, so the delays are within `8 * 2^-24 * R_max / C`: 1.6 picoseconds
+ * per kilometre of extent, 0.010 radians (0.0016 cycles) of phase at 1 GHz.
+ *
+ * `positions_xyz_in_uvw_out` must be populated with `xyz` positions.
+ * Its contents will be overwritten with `uvw` positions.
+ */
+void calc_position_delays_f(
+	float* positions_xyz_in_uvw_out,
+	int position_count,
+	int reference_position_index,
+	double hour_angle_rad,
+	double declination_rad,
+	double longitude_rad,
+	float* delays
+) {
+	calc_frame_transform_t transform;
+	calc_frame_transform_to_uvw_from_xyz(&transform, hour_angle_rad, declination_rad, longitude_rad);
+	calc_frame_transform_apply_f(&transform, positions_xyz_in_uvw_out, position_count);
+	const float reference_w = positions_xyz_in_uvw_out[reference_position_index*3 + 2];
+	for (int i = 0; i < position_count; i++) {
+		delays[i] = (positions_xyz_in_uvw_out[i*3 + 2] - reference_w) / (float) RADIOINTERFEROMETERY_C;
+	}
+}
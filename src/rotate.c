@@ -0,0 +1,275 @@
+#include "radiointerferometryc99.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define RADIOINTERFEROMETRY_ROTATE_X86
+#include <immintrin.h>
+#endif
+#if defined(__aarch64__)
+#define RADIOINTERFEROMETRY_ROTATE_NEON
+#include <arm_neon.h>
+#endif
+
+static void _positions_transform_scalar(
+	double* positions,
+	int position_count,
+	const double pre_translation[3],
+	const double rotation[3][3],
+	const double post_translation[3]
+) {
+	double x, y, z;
+	for (int i = 0; i < position_count; i++) {
+		x = positions[3*i + 0] + pre_translation[0];
+		y = positions[3*i + 1] + pre_translation[1];
+		z = positions[3*i + 2] + pre_translation[2];
+		positions[3*i + 0] = rotation[0][0]*x + rotation[0][1]*y + rotation[0][2]*z + post_translation[0];
+		positions[3*i + 1] = rotation[1][0]*x + rotation[1][1]*y + rotation[1][2]*z + post_translation[1];
+		positions[3*i + 2] = rotation[2][0]*x + rotation[2][1]*y + rotation[2][2]*z + post_translation[2];
+	}
+}
+
+#ifdef RADIOINTERFEROMETRY_ROTATE_X86
+/*
+ * 4 positions per iteration. The (x, y) pairs of positions {0, 2} and {1, 3}
+ * are loaded into two registers, which unpack to X and Y, and vice versa.
+ */
+__attribute__((target("avx2,fma")))
+static void _positions_transform_avx2(
+	double* positions,
+	int position_count,
+	const double pre_translation[3],
+	const double rotation[3][3],
+	const double post_translation[3]
+) {
+	const __m256d m00 = _mm256_set1_pd(rotation[0][0]), m01 = _mm256_set1_pd(rotation[0][1]), m02 = _mm256_set1_pd(rotation[0][2]);
+	const __m256d m10 = _mm256_set1_pd(rotation[1][0]), m11 = _mm256_set1_pd(rotation[1][1]), m12 = _mm256_set1_pd(rotation[1][2]);
+	const __m256d m20 = _mm256_set1_pd(rotation[2][0]), m21 = _mm256_set1_pd(rotation[2][1]), m22 = _mm256_set1_pd(rotation[2][2]);
+	const __m256d a0 = _mm256_set1_pd(pre_translation[0]), a1 = _mm256_set1_pd(pre_translation[1]), a2 = _mm256_set1_pd(pre_translation[2]);
+	const __m256d t0 = _mm256_set1_pd(post_translation[0]), t1 = _mm256_set1_pd(post_translation[1]), t2 = _mm256_set1_pd(post_translation[2]);
+	__m256d xy02, xy13, x, y, z, rx, ry, rz;
+	__m128d z01, z23;
+	double* p;
+	int i = 0;
+	for (; i + 4 <= position_count; i += 4) {
+		p = positions + 3*i;
+		xy02 = _mm256_insertf128_pd(_mm256_castpd128_pd256(_mm_loadu_pd(p + 0)), _mm_loadu_pd(p + 6), 1);
+		xy13 = _mm256_insertf128_pd(_mm256_castpd128_pd256(_mm_loadu_pd(p + 3)), _mm_loadu_pd(p + 9), 1);
+		x = _mm256_add_pd(_mm256_unpacklo_pd(xy02, xy13), a0);
+		y = _mm256_add_pd(_mm256_unpackhi_pd(xy02, xy13), a1);
+		z = _mm256_add_pd(_mm256_set_pd(p[11], p[8], p[5], p[2]), a2);
+
+		rx = _mm256_add_pd(_mm256_fmadd_pd(m02, z, _mm256_fmadd_pd(m01, y, _mm256_mul_pd(m00, x))), t0);
+		ry = _mm256_add_pd(_mm256_fmadd_pd(m12, z, _mm256_fmadd_pd(m11, y, _mm256_mul_pd(m10, x))), t1);
+		rz = _mm256_add_pd(_mm256_fmadd_pd(m22, z, _mm256_fmadd_pd(m21, y, _mm256_mul_pd(m20, x))), t2);
+
+		xy02 = _mm256_unpacklo_pd(rx, ry);
+		xy13 = _mm256_unpackhi_pd(rx, ry);
+		_mm_storeu_pd(p + 0, _mm256_castpd256_pd128(xy02));
+		_mm_storeu_pd(p + 6, _mm256_extractf128_pd(xy02, 1));
+		_mm_storeu_pd(p + 3, _mm256_castpd256_pd128(xy13));
+		_mm_storeu_pd(p + 9, _mm256_extractf128_pd(xy13, 1));
+		z01 = _mm256_castpd256_pd128(rz);
+		z23 = _mm256_extractf128_pd(rz, 1);
+		_mm_storel_pd(p + 2, z01);
+		_mm_storeh_pd(p + 5, z01);
+		_mm_storel_pd(p + 8, z23);
+		_mm_storeh_pd(p + 11, z23);
+	}
+	_positions_transform_scalar(positions + 3*i, position_count - i, pre_translation, rotation, post_translation);
+}
+
+/*
+ * 8 positions per iteration, gathered and scattered with a stride of 3.
+ */
+__attribute__((target("avx512f")))
+static void _positions_transform_avx512(
+	double* positions,
+	int position_count,
+	const double pre_translation[3],
+	const double rotation[3][3],
+	const double post_translation[3]
+) {
+	const __m512d m00 = _mm512_set1_pd(rotation[0][0]), m01 = _mm512_set1_pd(rotation[0][1]), m02 = _mm512_set1_pd(rotation[0][2]);
+	const __m512d m10 = _mm512_set1_pd(rotation[1][0]), m11 = _mm512_set1_pd(rotation[1][1]), m12 = _mm512_set1_pd(rotation[1][2]);
+	const __m512d m20 = _mm512_set1_pd(rotation[2][0]), m21 = _mm512_set1_pd(rotation[2][1]), m22 = _mm512_set1_pd(rotation[2][2]);
+	const __m512d a0 = _mm512_set1_pd(pre_translation[0]), a1 = _mm512_set1_pd(pre_translation[1]), a2 = _mm512_set1_pd(pre_translation[2]);
+	const __m512d t0 = _mm512_set1_pd(post_translation[0]), t1 = _mm512_set1_pd(post_translation[1]), t2 = _mm512_set1_pd(post_translation[2]);
+	const __m512i stride = _mm512_set_epi64(21, 18, 15, 12, 9, 6, 3, 0);
+	__m512d x, y, z;
+	double* p;
+	int i = 0;
+	for (; i + 8 <= position_count; i += 8) {
+		p = positions + 3*i;
+		x = _mm512_add_pd(_mm512_i64gather_pd(stride, p + 0, 8), a0);
+		y = _mm512_add_pd(_mm512_i64gather_pd(stride, p + 1, 8), a1);
+		z = _mm512_add_pd(_mm512_i64gather_pd(stride, p + 2, 8), a2);
+
+		_mm512_i64scatter_pd(p + 0, stride, _mm512_add_pd(_mm512_fmadd_pd(m02, z, _mm512_fmadd_pd(m01, y, _mm512_mul_pd(m00, x))), t0), 8);
+		_mm512_i64scatter_pd(p + 1, stride, _mm512_add_pd(_mm512_fmadd_pd(m12, z, _mm512_fmadd_pd(m11, y, _mm512_mul_pd(m10, x))), t1), 8);
+		_mm512_i64scatter_pd(p + 2, stride, _mm512_add_pd(_mm512_fmadd_pd(m22, z, _mm512_fmadd_pd(m21, y, _mm512_mul_pd(m20, x))), t2), 8);
+	}
+	_positions_transform_scalar(positions + 3*i, position_count - i, pre_translation, rotation, post_translation);
+}
+#endif
+
+#ifdef RADIOINTERFEROMETRY_ROTATE_NEON
+/*
+ * 2 positions per iteration, de-interleaved by the structure load.
+ */
+static void _positions_transform_neon(
+	double* positions,
+	int position_count,
+	const double pre_translation[3],
+	const double rotation[3][3],
+	const double post_translation[3]
+) {
+	float64x2x3_t xyz, rotated;
+	int i = 0;
+	for (; i + 2 <= position_count; i += 2) {
+		xyz = vld3q_f64(positions + 3*i);
+		for (int c = 0; c < 3; c++) {
+			xyz.val[c] = vaddq_f64(xyz.val[c], vdupq_n_f64(pre_translation[c]));
+		}
+		for (int r = 0; r < 3; r++) {
+			rotated.val[r] = vaddq_f64(
+				vfmaq_n_f64(
+					vfmaq_n_f64(vmulq_n_f64(xyz.val[0], rotation[r][0]), xyz.val[1], rotation[r][1]),
+					xyz.val[2], rotation[r][2]
+				),
+				vdupq_n_f64(post_translation[r])
+			);
+		}
+		vst3q_f64(positions + 3*i, rotated);
+	}
+	_positions_transform_scalar(positions + 3*i, position_count - i, pre_translation, rotation, post_translation);
+}
+#endif
+
+int calc_rotation_kernel_supported(enum rotation_kernels kernel) {
+	switch (kernel) {
+		case ROTATION_KERNEL_SCALAR:
+			return 1;
+#ifdef RADIOINTERFEROMETRY_ROTATE_X86
+		case ROTATION_KERNEL_AVX2:
+			return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") ? 1 : 0;
+		case ROTATION_KERNEL_AVX512:
+			return __builtin_cpu_supports("avx512f") ? 1 : 0;
+#endif
+#ifdef RADIOINTERFEROMETRY_ROTATE_NEON
+		case ROTATION_KERNEL_NEON:
+			return 1;
+#endif
+		default:
+			return 0;
+	}
+}
+
+/*
+ * The AVX-512 kernel is not a candidate: its gathers and scatters make it
+ * slower than the AVX2 kernel, so it only runs when asked for by name.
+ */
+static enum rotation_kernels _select_rotation_kernel(void) {
+	if (calc_rotation_kernel_supported(ROTATION_KERNEL_AVX2)) {
+		return ROTATION_KERNEL_AVX2;
+	}
+	if (calc_rotation_kernel_supported(ROTATION_KERNEL_NEON)) {
+		return ROTATION_KERNEL_NEON;
+	}
+	return ROTATION_KERNEL_SCALAR;
+}
+
+/*
+ * Selected on first use. Racing threads select the same kernel, the atomics
+ * only keep the accesses well defined.
+ */
+static int _default_rotation_kernel = -1;
+
+static enum rotation_kernels _get_default_rotation_kernel(void) {
+	int kernel = __atomic_load_n(&_default_rotation_kernel, __ATOMIC_RELAXED);
+	if (kernel < 0) {
+		kernel = _select_rotation_kernel();
+		__atomic_store_n(&_default_rotation_kernel, kernel, __ATOMIC_RELAXED);
+	}
+	return (enum rotation_kernels) kernel;
+}
+
+static void _positions_transform_dispatch(
+	double* positions,
+	int position_count,
+	const double pre_translation[3],
+	const double rotation[3][3],
+	const double post_translation[3],
+	enum rotation_kernels kernel
+) {
+	switch (kernel) {
+#ifdef RADIOINTERFEROMETRY_ROTATE_X86
+		case ROTATION_KERNEL_AVX2:
+			_positions_transform_avx2(positions, position_count, pre_translation, rotation, post_translation);
+			break;
+		case ROTATION_KERNEL_AVX512:
+			_positions_transform_avx512(positions, position_count, pre_translation, rotation, post_translation);
+			break;
+#endif
+#ifdef RADIOINTERFEROMETRY_ROTATE_NEON
+		case ROTATION_KERNEL_NEON:
+			_positions_transform_neon(positions, position_count, pre_translation, rotation, post_translation);
+			break;
+#endif
+		default:
+			_positions_transform_scalar(positions, position_count, pre_translation, rotation, post_translation);
+	}
+}
+
+/*
+ * Applies `positions = rotation*(positions + pre_translation) + post_translation`
+ * with the given kernel, falling back to the scalar kernel if it is not
+ * supported.
+ */
+void calc_positions_transform_with_kernel(
+	double* positions,
+	int position_count,
+	const double pre_translation[3],
+	const double rotation[3][3],
+	const double post_translation[3],
+	enum rotation_kernels kernel
+) {
+	if (!calc_rotation_kernel_supported(kernel)) {
+		kernel = ROTATION_KERNEL_SCALAR;
+	}
+	_positions_transform_dispatch(positions, position_count, pre_translation, rotation, post_translation, kernel);
+}
+
+/*
+ * As `calc_positions_transform_with_kernel`, with the fastest kernel the CPU
+ * supports.
+ */
+void calc_positions_transform(
+	double* positions,
+	int position_count,
+	const double pre_translation[3],
+	const double rotation[3][3],
+	const double post_translation[3]
+) {
+	_positions_transform_dispatch(positions, position_count, pre_translation, rotation, post_translation, _get_default_rotation_kernel());
+}
+
+void calc_positions_rotate_with_kernel(
+	double* positions,
+	int position_count,
+	const double rotation[3][3],
+	enum rotation_kernels kernel
+) {
+	const double no_translation[3] = {0.0, 0.0, 0.0};
+	calc_positions_transform_with_kernel(positions, position_count, no_translation, rotation, no_translation, kernel);
+}
+
+/*
+ * Applies `rotation` with the fastest kernel the CPU supports.
+ */
+void calc_positions_rotate(
+	double* positions,
+	int position_count,
+	const double rotation[3][3]
+) {
+	const double no_translation[3] = {0.0, 0.0, 0.0};
+	_positions_transform_dispatch(positions, position_count, no_translation, rotation, no_translation, _get_default_rotation_kernel());
+}
@@ -0,0 +1,207 @@
+#include <string.h>
+
+#include "radiointerferometryc99.h"
+
+/*
+ * A NULL `geodesy` is WGS84.
+ */
+void calc_site_init(
+	calc_site_t* site,
+	double longitude_rad,
+	double latitude_rad,
+	double altitude,
+	const geodesy_t* geodesy
+) {
+	site->longitude_rad = longitude_rad;
+	site->latitude_rad = latitude_rad;
+	site->altitude = altitude;
+	if (geodesy == NULL) {
+		geodesy_from_af_inv(&site->geodesy, WGS84_A_METERS, WGS84_F_INV);
+	}
+	else {
+		site->geodesy = *geodesy;
+	}
+	calc_ecef_from_lla(site->ecef, longitude_rad, latitude_rad, altitude, &site->geodesy);
+
+	calc_frame_transform_identity(&site->xyz_from_ecef);
+	calc_frame_transform_identity(&site->ecef_from_xyz);
+	for (int i = 0; i < 3; i++) {
+		site->xyz_from_ecef.pre_translation[i] = -site->ecef[i];
+		site->ecef_from_xyz.post_translation[i] = site->ecef[i];
+	}
+	calc_frame_transform_to_enu_from_xyz(&site->enu_from_xyz, longitude_rad, latitude_rad, altitude);
+	calc_frame_transform_to_xyz_from_enu(&site->xyz_from_enu, longitude_rad, latitude_rad, altitude);
+	calc_frame_transform_compose(&site->enu_from_ecef, &site->xyz_from_ecef, &site->enu_from_xyz);
+	calc_frame_transform_compose(&site->ecef_from_enu, &site->xyz_from_enu, &site->ecef_from_xyz);
+}
+
+void calc_position_to_xyz_frame_from_ecef_with_site(
+	double* positions,
+	int position_count,
+	const calc_site_t* site
+) {
+	calc_frame_transform_apply(&site->xyz_from_ecef, positions, position_count);
+}
+
+void calc_position_to_ecef_frame_from_xyz_with_site(
+	double* positions,
+	int position_count,
+	const calc_site_t* site
+) {
+	calc_frame_transform_apply(&site->ecef_from_xyz, positions, position_count);
+}
+
+void calc_position_to_xyz_frame_from_enu_with_site(
+	double* positions,
+	int position_count,
+	const calc_site_t* site
+) {
+	calc_frame_transform_apply(&site->xyz_from_enu, positions, position_count);
+}
+
+void calc_position_to_enu_frame_from_xyz_with_site(
+	double* positions,
+	int position_count,
+	const calc_site_t* site
+) {
+	calc_frame_transform_apply(&site->enu_from_xyz, positions, position_count);
+}
+
+void calc_position_to_enu_frame_from_ecef_with_site(
+	double* positions,
+	int position_count,
+	const calc_site_t* site
+) {
+	calc_frame_transform_apply(&site->enu_from_ecef, positions, position_count);
+}
+
+void calc_position_to_ecef_frame_from_enu_with_site(
+	double* positions,
+	int position_count,
+	const calc_site_t* site
+) {
+	calc_frame_transform_apply(&site->ecef_from_enu, positions, position_count);
+}
+
+void calc_position_to_uvw_frame_from_xyz_with_site(
+	double* positions,
+	int position_count,
+	double hour_angle_rad,
+	double declination_rad,
+	const calc_site_t* site
+) {
+	calc_position_to_uvw_frame_from_xyz(positions, position_count, hour_angle_rad, declination_rad, site->longitude_rad);
+}
+
+/*
+ * Effects `enu -> xyz -> uvw`, the static ENU to XYZ rotation of the site
+ * sparing the trigonometry of the latitude.
+ */
+void calc_position_to_uvw_frame_from_enu_with_site(
+	double* positions,
+	int position_count,
+	double hour_angle_rad,
+	double declination_rad,
+	const calc_site_t* site
+) {
+	calc_frame_transform_t transform;
+	calc_frame_transform_to_uvw_from_xyz(&transform, hour_angle_rad, declination_rad, site->longitude_rad);
+	calc_frame_transform_compose(&transform, &site->xyz_from_enu, &transform);
+	calc_frame_transform_apply(&transform, positions, position_count);
+}
+
+void calc_position_delays_with_site(
+	double* positions_xyz_in_uvw_out,
+	int position_count,
+	int reference_position_index,
+	double hour_angle_rad,
+	double declination_rad,
+	const calc_site_t* site,
+	double* delays
+) {
+	calc_position_delays(
+		positions_xyz_in_uvw_out,
+		position_count,
+		reference_position_index,
+		hour_angle_rad,
+		declination_rad,
+		site->longitude_rad,
+		delays
+	);
+}
+
+void calc_delay_matrix_with_site(
+	const double* positions_xyz,
+	int position_count,
+	int reference_position_index,
+	const double* hour_angle_rad,
+	const double* declination_rad,
+	int beam_count,
+	const calc_site_t* site,
+	double* delays
+) {
+	calc_delay_matrix(
+		positions_xyz,
+		position_count,
+		reference_position_index,
+		hour_angle_rad,
+		declination_rad,
+		beam_count,
+		site->longitude_rad,
+		delays
+	);
+}
+
+void calc_independent_astrom_with_site(
+	const calc_site_t* site,
+	double date1,
+	double date2,
+	double dut1,
+	eraASTROM* astrom
+) {
+	calc_independent_astrom_with_two_part_date(
+		site->longitude_rad,
+		site->latitude_rad,
+		site->altitude,
+		date1, date2,
+		dut1,
+		astrom
+	);
+}
+
+void calc_ha_dec_rad_with_site(
+	double ra_rad,
+	double dec_rad,
+	const calc_site_t* site,
+	double date1,
+	double date2,
+	double dut1,
+	double* hour_angle_rad,
+	double* declination_rad
+) {
+	calc_ha_dec_rad_with_two_part_date(
+		ra_rad,
+		dec_rad,
+		site->longitude_rad,
+		site->latitude_rad,
+		site->altitude,
+		date1, date2,
+		dut1,
+		hour_angle_rad,
+		declination_rad
+	);
+}
+
+void calc_astrom_cache_init_with_site(
+	calc_astrom_cache_t* cache,
+	const calc_site_t* site,
+	double window_seconds
+) {
+	calc_astrom_cache_init(
+		cache,
+		site->longitude_rad,
+		site->latitude_rad,
+		site->altitude,
+		window_seconds
+	);
+}
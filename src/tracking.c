@@ -0,0 +1,225 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "radiointerferometryc99.h"
+
+/*
+ * Returns:
+ *  0: success
+ *  6: error allocating memory
+ */
+int calc_tracking_session_init(
+	calc_tracking_session_t* session,
+	const calc_site_t* site,
+	const double* positions_xyz,
+	int antenna_count,
+	int reference_antenna_index,
+	const double* ra_rad,
+	const double* dec_rad,
+	int beam_count,
+	const radiointerferometry_iers_table_t* iers_table,
+	double dut1,
+	double astrom_window_seconds
+) {
+	memset(session, 0, sizeof(calc_tracking_session_t));
+	session->site = *site;
+	session->antenna_count = antenna_count;
+	session->reference_antenna_index = reference_antenna_index;
+	session->beam_count = beam_count;
+	session->iers_table = iers_table;
+	session->dut1 = dut1;
+	calc_astrom_cache_init_with_site(&session->astrom_cache, site, astrom_window_seconds);
+	session->date1 = NAN;
+	session->date2 = NAN;
+	if (iers_table != NULL) {
+		radiointerferometry_iers_cursor_init(
+			&session->iers_cursor,
+			iers_table,
+			RADIOINTERFEROMETRY_IERS_COLUMN_MASK(RADIOINTERFEROMETRY_IERS_COLUMN_UT1_UTC_A)
+		);
+	}
+
+	session->positions_xyz = malloc(3*antenna_count*sizeof(double));
+	session->beam_ra_rad = malloc(beam_count*sizeof(double));
+	session->beam_dec_rad = malloc(beam_count*sizeof(double));
+	session->beam_changed = malloc(beam_count*sizeof(bool));
+	session->hour_angle_rad = malloc(beam_count*sizeof(double));
+	session->declination_rad = malloc(beam_count*sizeof(double));
+	session->delay_coefficients = malloc(3*beam_count*sizeof(double));
+	session->delays = calloc((size_t)beam_count*antenna_count, sizeof(double));
+	if (
+		session->positions_xyz == NULL
+		|| session->beam_ra_rad == NULL
+		|| session->beam_dec_rad == NULL
+		|| session->beam_changed == NULL
+		|| session->hour_angle_rad == NULL
+		|| session->declination_rad == NULL
+		|| session->delay_coefficients == NULL
+		|| session->delays == NULL
+	) {
+		calc_tracking_session_free(session);
+		return 6;
+	}
+	memcpy(session->positions_xyz, positions_xyz, 3*antenna_count*sizeof(double));
+	memcpy(session->beam_ra_rad, ra_rad, beam_count*sizeof(double));
+	memcpy(session->beam_dec_rad, dec_rad, beam_count*sizeof(double));
+	for (int b = 0; b < beam_count; b++) {
+		session->beam_changed[b] = true;
+	}
+	return 0;
+}
+
+void calc_tracking_session_free(
+	calc_tracking_session_t* session
+) {
+	free(session->positions_xyz);
+	free(session->beam_ra_rad);
+	free(session->beam_dec_rad);
+	free(session->beam_changed);
+	free(session->hour_angle_rad);
+	free(session->declination_rad);
+	free(session->delay_coefficients);
+	free(session->delays);
+	session->positions_xyz = NULL;
+	session->beam_ra_rad = NULL;
+	session->beam_dec_rad = NULL;
+	session->beam_changed = NULL;
+	session->hour_angle_rad = NULL;
+	session->declination_rad = NULL;
+	session->delay_coefficients = NULL;
+	session->delays = NULL;
+}
+
+/*
+ * Takes effect at the next `calc_tracking_session_advance`, which only
+ * recomputes the changed beams if the time is unchanged.
+ */
+void calc_tracking_session_set_beam(
+	calc_tracking_session_t* session,
+	int beam_index,
+	double ra_rad,
+	double dec_rad
+) {
+	session->beam_ra_rad[beam_index] = ra_rad;
+	session->beam_dec_rad[beam_index] = dec_rad;
+	session->beam_changed[beam_index] = true;
+}
+
+/*
+ * The UT1-UTC of the date, from the IERS table through the session's cursor
+ * (which only brackets anew when the day changes), else the fixed value.
+ */
+static int _tracking_session_dut1(
+	calc_tracking_session_t* session,
+	double date1,
+	double date2,
+	double* dut1
+) {
+	double values[RADIOINTERFEROMETRY_IERS_COLUMN_COUNT];
+	int rv;
+	if (session->iers_table == NULL) {
+		*dut1 = session->dut1;
+		return 0;
+	}
+	rv = radiointerferometry_iers_cursor_get(
+		&session->iers_cursor,
+		(date1 - 2400000.5) + date2,
+		values
+	);
+	if (rv == 0) {
+		*dut1 = values[RADIOINTERFEROMETRY_IERS_COLUMN_UT1_UTC_A];
+	}
+	return rv;
+}
+
+/*
+ * The delays of `beam_count` beams from `beam_index`, into the session's
+ * scratch and delays, without allocating.
+ */
+static void _tracking_session_beam_delays(
+	calc_tracking_session_t* session,
+	int beam_index,
+	int beam_count
+) {
+	calc_delay_matrix_workspace(
+		session->positions_xyz,
+		session->antenna_count,
+		session->reference_antenna_index,
+		session->hour_angle_rad + beam_index,
+		session->declination_rad + beam_index,
+		beam_count,
+		session->site.longitude_rad,
+		session->delay_coefficients,
+		session->delays + (size_t)beam_index*session->antenna_count
+	);
+}
+
+/*
+ * Brings the session to the UTC date `date1 + date2` (as for ERFA), a no-op
+ * if neither it nor the beams have changed. A new date renews the hour angle
+ * and declination of all beams, and their delays; at the same date only
+ * those of the changed beams are.
+ *
+ * Returns:
+ *  0: success
+ *  otherwise the `radiointerferometry_iers_cursor_get` error, the session
+ *  left as at its previous date.
+ */
+int calc_tracking_session_advance(
+	calc_tracking_session_t* session,
+	double date1,
+	double date2
+) {
+	double dut1;
+	int rv;
+	if (date1 == session->date1 && date2 == session->date2) {
+		for (int b = 0; b < session->beam_count; b++) {
+			if (session->beam_changed[b]) {
+				calc_ha_dec_rad_batch_with_independent_astrom(
+					session->beam_ra_rad + b,
+					session->beam_dec_rad + b,
+					1,
+					&session->astrom_cache.astrom,
+					session->hour_angle_rad + b,
+					session->declination_rad + b
+				);
+				_tracking_session_beam_delays(session, b, 1);
+				session->beam_changed[b] = false;
+			}
+		}
+		return 0;
+	}
+
+	rv = _tracking_session_dut1(session, date1, date2, &dut1);
+	if (rv != 0) {
+		return rv;
+	}
+	calc_astrom_cache_update_with_two_part_date(&session->astrom_cache, date1, date2, dut1);
+	calc_ha_dec_rad_batch_with_independent_astrom(
+		session->beam_ra_rad,
+		session->beam_dec_rad,
+		session->beam_count,
+		&session->astrom_cache.astrom,
+		session->hour_angle_rad,
+		session->declination_rad
+	);
+	_tracking_session_beam_delays(session, 0, session->beam_count);
+	for (int b = 0; b < session->beam_count; b++) {
+		session->beam_changed[b] = false;
+	}
+	session->date1 = date1;
+	session->date2 = date2;
+	session->dut1_current = dut1;
+	return 0;
+}
+
+/*
+ * The delays (seconds) of the last `calc_tracking_session_advance`, in
+ * `delays[beam*antenna_count + antenna]`. The buffer lives as long as the
+ * session, and is overwritten by each advance.
+ */
+const double* calc_tracking_session_get_delays(
+	const calc_tracking_session_t* session
+) {
+	return session->delays;
+}
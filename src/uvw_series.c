@@ -0,0 +1,121 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "radiointerferometryc99.h"
+
+typedef struct {
+	const double* positions_xyz;
+	int position_count;
+	double hour_angle_start_rad;
+	double hour_angle_step_rad;
+	double sin_declination;
+	double cos_declination;
+	double longitude_rad;
+	int reanchor_interval;
+	int time_begin;
+	int time_end;
+	double* uvw;
+} _uvw_series_chunk_t;
+
+static void* _uvw_series_chunk_worker(void* chunk_void) {
+	const _uvw_series_chunk_t* chunk = chunk_void;
+	// theta = longitude - hour_angle decreases by the step each time
+	const double sin_step = sin(chunk->hour_angle_step_rad);
+	const double cos_step = cos(chunk->hour_angle_step_rad);
+	const double sin_dec = chunk->sin_declination;
+	const double cos_dec = chunk->cos_declination;
+	const size_t time_stride = 3*(size_t)chunk->position_count;
+	double sin_theta = 0.0, cos_theta = 1.0, next_sin_theta, theta;
+	double rotation[3][3];
+	double* uvw;
+
+	for (int t = chunk->time_begin; t < chunk->time_end; t++) {
+		if ((t - chunk->time_begin) % chunk->reanchor_interval == 0) {
+			theta = chunk->longitude_rad - (chunk->hour_angle_start_rad + t*chunk->hour_angle_step_rad);
+			sin_theta = sin(theta);
+			cos_theta = cos(theta);
+		}
+		else {
+			next_sin_theta = sin_theta*cos_step - cos_theta*sin_step;
+			cos_theta = cos_theta*cos_step + sin_theta*sin_step;
+			sin_theta = next_sin_theta;
+		}
+
+		// per `calc_frame_transform_to_uvw_from_xyz`
+		rotation[0][0] = -sin_theta;         rotation[0][1] = cos_theta;          rotation[0][2] = 0.0;
+		rotation[1][0] = -sin_dec*cos_theta; rotation[1][1] = -sin_dec*sin_theta; rotation[1][2] = cos_dec;
+		rotation[2][0] = cos_dec*cos_theta;  rotation[2][1] = cos_dec*sin_theta;  rotation[2][2] = sin_dec;
+
+		uvw = chunk->uvw + t*time_stride;
+		memcpy(uvw, chunk->positions_xyz, time_stride*sizeof(double));
+		calc_positions_rotate(uvw, chunk->position_count, (const double (*)[3]) rotation);
+	}
+	return NULL;
+}
+
+void calc_uvw_time_series(
+	const double* positions_xyz,
+	int position_count,
+	double hour_angle_start_rad,
+	double hour_angle_step_rad,
+	int time_count,
+	double declination_rad,
+	double longitude_rad,
+	int reanchor_interval,
+	int thread_count,
+	double* uvw
+) {
+	if (reanchor_interval < 1) {
+		reanchor_interval = CALC_UVW_SERIES_REANCHOR_INTERVAL;
+	}
+	if (thread_count < 1) {
+		thread_count = 1;
+	}
+	if (thread_count > time_count) {
+		thread_count = time_count > 0 ? time_count : 1;
+	}
+	_uvw_series_chunk_t template = {
+		.positions_xyz = positions_xyz,
+		.position_count = position_count,
+		.hour_angle_start_rad = hour_angle_start_rad,
+		.hour_angle_step_rad = hour_angle_step_rad,
+		.sin_declination = sin(declination_rad),
+		.cos_declination = cos(declination_rad),
+		.longitude_rad = longitude_rad,
+		.reanchor_interval = reanchor_interval,
+		.time_begin = 0,
+		.time_end = time_count,
+		.uvw = uvw,
+	};
+	_uvw_series_chunk_t* chunks = malloc(thread_count*sizeof(_uvw_series_chunk_t));
+	pthread_t* threads = malloc(thread_count*sizeof(pthread_t));
+	int* started = calloc(thread_count, sizeof(int));
+	if (chunks == NULL || threads == NULL || started == NULL) {
+		// the calling thread takes all time steps, as a single chunk
+		_uvw_series_chunk_worker(&template);
+		free(chunks);
+		free(threads);
+		free(started);
+		return;
+	}
+
+	for (int t = 0; t < thread_count; t++) {
+		chunks[t] = template;
+		chunks[t].time_begin = (int)(((long long)time_count*t)/thread_count);
+		chunks[t].time_end = (int)(((long long)time_count*(t+1))/thread_count);
+		// the calling thread takes the first chunk, and any that fail to start
+		started[t] = t > 0 && pthread_create(threads+t, NULL, _uvw_series_chunk_worker, chunks+t) == 0;
+	}
+	for (int t = 0; t < thread_count; t++) {
+		if (started[t]) {
+			pthread_join(threads[t], NULL);
+		}
+		else {
+			_uvw_series_chunk_worker(chunks+t);
+		}
+	}
+
+	free(chunks);
+	free(threads);
+	free(started);
+}
@@ -0,0 +1,92 @@
+#include <stdio.h>
+#include <math.h>
+
+#include "radiointerferometryc99.h"
+
+int main(int argc, const char * argv[]) {
+  double latitude = 33.97391383157283*RADIOINTERFEROMETERY_PI/180.0;
+  double longitude = -116.5833461618117*RADIOINTERFEROMETERY_PI/180.0;
+  double altitude = 1073.4610445341686;
+  double ra = 8.3*RADIOINTERFEROMETERY_PI/180;
+  double dec = 16.3*RADIOINTERFEROMETERY_PI/180;
+  double time_jd = 2400000.5+60000.25;
+  double dut1 = -0.0153;
+  double window_seconds = 60.0;
+  // 25 microarcseconds per second of window, in radians
+  double tolerance = 25e-6/3600*RADIOINTERFEROMETERY_PI/180*window_seconds;
+
+  calc_astrom_cache_t cache;
+  calc_astrom_cache_init(&cache, longitude, latitude, altitude, window_seconds);
+
+  eraASTROM astrom;
+  double ha, dec_out, cached_ha, cached_dec_out, error, max_error = 0;
+  int failures = 0;
+  for (int step = 0; step < 360; step++) {
+    double timemjd = time_jd + step*0.5/RADIOINTERFEROMETERY_DAYSEC;
+
+    calc_ha_dec_rad_with_independent_astrom(
+      ra, dec,
+      calc_astrom_cache_update(&cache, timemjd, dut1),
+      &cached_ha, &cached_dec_out
+    );
+    calc_independent_astrom(longitude, latitude, altitude, timemjd, dut1, &astrom);
+    calc_ha_dec_rad_with_independent_astrom(ra, dec, &astrom, &ha, &dec_out);
+
+    error = hypot(eraAnpm(cached_ha - ha)*cos(dec_out), cached_dec_out - dec_out);
+    if (error > max_error) {
+      max_error = error;
+    }
+    if (error > tolerance) {
+      printf("step %d: error %e rad exceeds %e rad\n", step, error, tolerance);
+      failures++;
+    }
+  }
+  printf("max error: %e rad (tolerance %e rad)\n", max_error, tolerance);
+
+  // a change of dut1 within the window keeps the anchor, the Earth rotation
+  // angle taking the new value
+  const double anchor_timemjd = cache.anchor_timemjd;
+  const double changed_timemjd = anchor_timemjd + 1.0/RADIOINTERFEROMETERY_DAYSEC;
+  calc_ha_dec_rad_with_independent_astrom(
+    ra, dec,
+    calc_astrom_cache_update(&cache, changed_timemjd, dut1 + 0.1),
+    &cached_ha, &cached_dec_out
+  );
+  calc_ha_dec_rad(ra, dec, longitude, latitude, altitude, changed_timemjd, dut1 + 0.1, &ha, &dec_out);
+  error = hypot(eraAnpm(cached_ha - ha)*cos(dec_out), cached_dec_out - dec_out);
+  if (cache.anchor_timemjd != anchor_timemjd || error > tolerance) {
+    printf("dut1 change: anchor %f (was %f), error %e rad\n", cache.anchor_timemjd, anchor_timemjd, error);
+    failures++;
+  }
+
+  // the two-part date matches the single date it splits
+  double two_part_ha, two_part_dec_out;
+  calc_ha_dec_rad(ra, dec, longitude, latitude, altitude, time_jd, dut1, &ha, &dec_out);
+  calc_ha_dec_rad_with_two_part_date(ra, dec, longitude, latitude, altitude, 2460000.0, time_jd - 2460000.0, dut1, &two_part_ha, &two_part_dec_out);
+  error = hypot(eraAnpm(two_part_ha - ha)*cos(dec_out), two_part_dec_out - dec_out);
+  if (error > 1e-12) {
+    printf("two-part date hour angle and declination differ by %e rad\n", error);
+    failures++;
+  }
+  calc_ha_dec_rad_with_independent_astrom(
+    ra, dec,
+    calc_astrom_cache_update_with_two_part_date(&cache, 2460000.0, time_jd - 2460000.0, dut1),
+    &two_part_ha, &two_part_dec_out
+  );
+  error = hypot(eraAnpm(two_part_ha - ha)*cos(dec_out), two_part_dec_out - dec_out);
+  if (error > 1e-12) {
+    printf("two-part date cached hour angle and declination differ by %e rad\n", error);
+    failures++;
+  }
+
+  // the site context matches the site's coordinates
+  calc_site_t site;
+  calc_site_init(&site, longitude, latitude, altitude, NULL);
+  calc_ha_dec_rad_with_site(ra, dec, &site, time_jd, 0, dut1, &two_part_ha, &two_part_dec_out);
+  if (two_part_ha != ha || two_part_dec_out != dec_out) {
+    printf("site hour angle and declination differ\n");
+    failures++;
+  }
+
+  return failures;
+}
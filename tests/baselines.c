@@ -0,0 +1,78 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "radiointerferometryc99.h"
+
+#define ANTENNA_COUNT 97
+
+int main(int argc, const char * argv[]) {
+  double longitude = -116.5833461618117*RADIOINTERFEROMETERY_PI/180.0;
+  double positions_xyz[ANTENNA_COUNT*3], antenna_uvw[ANTENNA_COUNT*3];
+  const size_t baseline_count = calc_baseline_count(ANTENNA_COUNT);
+  int* antenna1 = malloc(baseline_count*sizeof(int));
+  int* antenna2 = malloc(baseline_count*sizeof(int));
+  double* baseline_uvw = malloc(3*baseline_count*sizeof(double));
+  double* baseline_lengths = malloc(baseline_count*sizeof(double));
+  const double hour_angle = 0.7, declination = 0.4;
+  const enum baseline_orderings orderings[] = {BASELINE_ORDERING_UPPER_TRIANGULAR, BASELINE_ORDERING_TRIANGULAR_BY_COLUMN};
+  const int thread_counts[] = {1, 3, 8};
+  int failures = 0;
+
+  for (int i = 0; i < ANTENNA_COUNT; i++) {
+    positions_xyz[3*i + 0] = 1200.0*sin(2.3*i);
+    positions_xyz[3*i + 1] = 900.0*cos(1.1*i);
+    positions_xyz[3*i + 2] = 15.0*sin(0.3*i);
+  }
+  memcpy(antenna_uvw, positions_xyz, sizeof(antenna_uvw));
+  calc_position_to_uvw_frame_from_xyz(antenna_uvw, ANTENNA_COUNT, hour_angle, declination, longitude);
+
+  for (int o = 0; o < 2; o++) {
+    calc_baseline_antennas(ANTENNA_COUNT, orderings[o], antenna1, antenna2);
+    // check the ordering itself
+    for (size_t b = 1; b < baseline_count; b++) {
+      int ordered = orderings[o] == BASELINE_ORDERING_UPPER_TRIANGULAR
+        ? (antenna1[b] == antenna1[b-1] && antenna2[b] == antenna2[b-1]+1) || (antenna1[b] == antenna1[b-1]+1 && antenna2[b] == antenna1[b])
+        : (antenna2[b] == antenna2[b-1] && antenna1[b] == antenna1[b-1]+1) || (antenna2[b] == antenna2[b-1]+1 && antenna1[b] == 0);
+      if (!ordered || antenna1[b] > antenna2[b]) {
+        printf("ordering %d, baseline %zu: (%d, %d) follows (%d, %d)\n", o, b, antenna1[b], antenna2[b], antenna1[b-1], antenna2[b-1]);
+        failures++;
+      }
+    }
+
+    for (int t = 0; t < 3; t++) {
+      memset(baseline_uvw, 0, 3*baseline_count*sizeof(double));
+      if (t == 2) {
+        if (calc_baseline_uvw_from_xyz(positions_xyz, ANTENNA_COUNT, hour_angle, declination, longitude, orderings[o], thread_counts[t], baseline_uvw, baseline_lengths) != 0) {
+          printf("ordering %d: from xyz failed\n", o);
+          failures++;
+        }
+      }
+      else {
+        calc_baseline_uvw(antenna_uvw, ANTENNA_COUNT, orderings[o], thread_counts[t], baseline_uvw, baseline_lengths);
+      }
+      for (size_t b = 0; b < baseline_count; b++) {
+        double length = 0.0;
+        for (int d = 0; d < 3; d++) {
+          double expected = antenna_uvw[3*antenna2[b] + d] - antenna_uvw[3*antenna1[b] + d];
+          length += expected*expected;
+          if (fabs(baseline_uvw[3*b + d] - expected) > 1e-9) {
+            printf("ordering %d, threads %d, baseline %zu (%d, %d)[%d]: %f != %f\n", o, thread_counts[t], b, antenna1[b], antenna2[b], d, baseline_uvw[3*b + d], expected);
+            failures++;
+          }
+        }
+        if (fabs(baseline_lengths[b] - sqrt(length)) > 1e-9) {
+          printf("ordering %d, threads %d, baseline %zu length: %f != %f\n", o, thread_counts[t], b, baseline_lengths[b], sqrt(length));
+          failures++;
+        }
+      }
+    }
+  }
+
+  free(antenna1);
+  free(antenna2);
+  free(baseline_uvw);
+  free(baseline_lengths);
+  printf("failures: %d\n", failures);
+  return failures;
+}
@@ -0,0 +1,73 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "radiointerferometryc99.h"
+
+#define ANTENNA_COUNT 300
+// spanning a partial second block of beams
+#define BEAM_COUNT (CALC_DELAY_MATRIX_BLOCK_BEAMS + 6)
+#define REFERENCE_INDEX 7
+
+int main(int argc, const char * argv[]) {
+  double latitude = 33.97391383157283*RADIOINTERFEROMETERY_PI/180.0;
+  double longitude = -116.5833461618117*RADIOINTERFEROMETERY_PI/180.0;
+  double* positions_xyz = malloc(ANTENNA_COUNT*3*sizeof(double));
+  double* positions = malloc(ANTENNA_COUNT*3*sizeof(double));
+  double* delays = malloc(BEAM_COUNT*ANTENNA_COUNT*sizeof(double));
+  float* delays_f = malloc(BEAM_COUNT*ANTENNA_COUNT*sizeof(float));
+  double* delays_workspace = malloc(BEAM_COUNT*ANTENNA_COUNT*sizeof(double));
+  double coefficients[3*BEAM_COUNT];
+  double expected[ANTENNA_COUNT];
+  double hour_angle[BEAM_COUNT], declination[BEAM_COUNT];
+
+  // a spiral of antennas
+  for (int i = 0; i < ANTENNA_COUNT; i++) {
+    positions_xyz[3*i + 0] = 10.0*i*cos(0.1*i);
+    positions_xyz[3*i + 1] = 10.0*i*sin(0.1*i);
+    positions_xyz[3*i + 2] = 0.01*i;
+  }
+  calc_position_to_xyz_frame_from_enu(positions_xyz, ANTENNA_COUNT, longitude, latitude, 0);
+  memcpy(positions, positions_xyz, ANTENNA_COUNT*3*sizeof(double));
+  for (int b = 0; b < BEAM_COUNT; b++) {
+    hour_angle[b] = -1.5 + 3.0*b/BEAM_COUNT;
+    declination[b] = -1.0 + 2.0*b/BEAM_COUNT;
+  }
+
+  calc_delay_matrix(positions_xyz, ANTENNA_COUNT, REFERENCE_INDEX, hour_angle, declination, BEAM_COUNT, longitude, delays);
+  calc_delay_matrix_f(positions_xyz, ANTENNA_COUNT, REFERENCE_INDEX, hour_angle, declination, BEAM_COUNT, longitude, delays_f);
+  calc_delay_matrix_workspace(positions_xyz, ANTENNA_COUNT, REFERENCE_INDEX, hour_angle, declination, BEAM_COUNT, longitude, coefficients, delays_workspace);
+
+  int failures = 0;
+  if (memcmp(positions, positions_xyz, ANTENNA_COUNT*3*sizeof(double)) != 0) {
+    printf("positions were modified\n");
+    failures++;
+  }
+  // the same arithmetic, whatever the blocking of the beams
+  if (memcmp(delays, delays_workspace, BEAM_COUNT*ANTENNA_COUNT*sizeof(double)) != 0) {
+    printf("workspace delays differ\n");
+    failures++;
+  }
+  for (int b = 0; b < BEAM_COUNT; b++) {
+    memcpy(positions, positions_xyz, ANTENNA_COUNT*3*sizeof(double));
+    calc_position_delays(positions, ANTENNA_COUNT, REFERENCE_INDEX, hour_angle[b], declination[b], longitude, expected);
+    for (int i = 0; i < ANTENNA_COUNT; i++) {
+      if (fabs(delays[b*ANTENNA_COUNT + i] - expected[i]) > 1e-18) {
+        printf("beam %d, antenna %d: %e != %e\n", b, i, delays[b*ANTENNA_COUNT + i], expected[i]);
+        failures++;
+      }
+      if (fabs(delays_f[b*ANTENNA_COUNT + i] - expected[i]) > 1e-7*fabs(expected[i]) + 1e-18) {
+        printf("beam %d, antenna %d: %e != %e (float)\n", b, i, delays_f[b*ANTENNA_COUNT + i], expected[i]);
+        failures++;
+      }
+    }
+  }
+
+  free(positions_xyz);
+  free(positions);
+  free(delays);
+  free(delays_f);
+  free(delays_workspace);
+  printf("failures: %d\n", failures);
+  return failures;
+}
@@ -0,0 +1,88 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "radiointerferometryc99.h"
+
+#define ANTENNA_COUNT 4
+
+static void direct_delays(
+  const double* positions_xyz,
+  double ra, double dec,
+  double longitude, double latitude, double altitude,
+  double timemjd, double dut1,
+  double* delays
+) {
+  double positions[ANTENNA_COUNT*3], hour_angle, declination;
+  memcpy(positions, positions_xyz, sizeof(positions));
+  calc_ha_dec_rad(ra, dec, longitude, latitude, altitude, timemjd, dut1, &hour_angle, &declination);
+  calc_position_delays(positions, ANTENNA_COUNT, 0, hour_angle, declination, longitude, delays);
+}
+
+int main(int argc, const char * argv[]) {
+  double latitude = 33.97391383157283*RADIOINTERFEROMETERY_PI/180.0;
+  double longitude = -116.5833461618117*RADIOINTERFEROMETERY_PI/180.0;
+  double altitude = 1073.4610445341686;
+  double ra = 8.3*RADIOINTERFEROMETERY_PI/180;
+  double dec = 16.3*RADIOINTERFEROMETERY_PI/180;
+  double dut1 = -0.0153;
+  double timemjd_start = 2400000.5+60000.25;
+  double timemjd_end = timemjd_start + 600.0/RADIOINTERFEROMETERY_DAYSEC;
+  double positions_xyz[ANTENNA_COUNT*3] = {
+    0, 0, 0,
+    1000, 200, 3,
+    -400, 800, 1,
+    3000, -2500, 10,
+  };
+  calc_position_to_xyz_frame_from_enu(positions_xyz, ANTENNA_COUNT, longitude, latitude, altitude);
+
+  calc_delay_model_t model;
+  int failures = calc_delay_model_fit(
+    &model,
+    positions_xyz, ANTENNA_COUNT, 0,
+    ra, dec,
+    longitude, latitude, altitude,
+    timemjd_start, timemjd_end, dut1,
+    10
+  );
+  printf("fit return code: %d, max residual: %e s\n", failures, model.max_residual);
+  if (failures != 0 || model.max_residual > 1e-12) {
+    return 1;
+  }
+
+  // finite differences of the direct delays, over steps long enough that the
+  // time resolution of the Julian date does not dominate
+  double rate_step = 10.0/RADIOINTERFEROMETERY_DAYSEC;
+  double acceleration_step = 60.0/RADIOINTERFEROMETERY_DAYSEC;
+  double delays[ANTENNA_COUNT], rates[ANTENNA_COUNT], accelerations[ANTENNA_COUNT];
+  double expected[ANTENNA_COUNT], before[ANTENNA_COUNT], after[ANTENNA_COUNT];
+  for (double timemjd = timemjd_start + 60.0/RADIOINTERFEROMETERY_DAYSEC; timemjd < timemjd_end - 60.0/RADIOINTERFEROMETERY_DAYSEC; timemjd += 17.3/RADIOINTERFEROMETERY_DAYSEC) {
+    calc_delay_model_evaluate(&model, timemjd, delays, rates, accelerations);
+
+    direct_delays(positions_xyz, ra, dec, longitude, latitude, altitude, timemjd, dut1, expected);
+    direct_delays(positions_xyz, ra, dec, longitude, latitude, altitude, timemjd - rate_step, dut1, before);
+    direct_delays(positions_xyz, ra, dec, longitude, latitude, altitude, timemjd + rate_step, dut1, after);
+    for (int a = 0; a < ANTENNA_COUNT; a++) {
+      if (fabs(delays[a] - expected[a]) > 1e-12) {
+        printf("delay %d: %e != %e\n", a, delays[a], expected[a]);
+        failures++;
+      }
+      if (fabs(rates[a] - (after[a] - before[a])/20.0) > 1e-13) {
+        printf("rate %d: %e != %e\n", a, rates[a], (after[a] - before[a])/20.0);
+        failures++;
+      }
+    }
+
+    direct_delays(positions_xyz, ra, dec, longitude, latitude, altitude, timemjd - acceleration_step, dut1, before);
+    direct_delays(positions_xyz, ra, dec, longitude, latitude, altitude, timemjd + acceleration_step, dut1, after);
+    for (int a = 0; a < ANTENNA_COUNT; a++) {
+      if (fabs(accelerations[a] - (after[a] - 2*expected[a] + before[a])/3600.0) > 1e-16) {
+        printf("acceleration %d: %e != %e\n", a, accelerations[a], (after[a] - 2*expected[a] + before[a])/3600.0);
+        failures++;
+      }
+    }
+  }
+
+  calc_delay_model_free(&model);
+  printf("failures: %d\n", failures);
+  return failures;
+}
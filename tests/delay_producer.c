@@ -0,0 +1,113 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <time.h>
+
+#include "radiointerferometryc99.h"
+
+#define ANTENNA_COUNT 16
+#define BEAM_COUNT 3
+#define SET_COUNT 50
+
+int main(int argc, const char * argv[]) {
+  double latitude = 33.97391383157283*RADIOINTERFEROMETERY_PI/180.0;
+  double longitude = -116.5833461618117*RADIOINTERFEROMETERY_PI/180.0;
+  double altitude = 1073.4610445341686;
+  double positions_xyz[ANTENNA_COUNT*3];
+  double ra[BEAM_COUNT], dec[BEAM_COUNT];
+  const double dut1 = -0.0153, date1 = 2460000.5, date2 = 0.25;
+  const double step_seconds = 0.01;
+  const struct timespec wait = {.tv_sec = 0, .tv_nsec = 1000000};
+  const double* delays;
+  unsigned long produced, underruns, waits = 0;
+  int status, rv, failures = 0;
+
+  for (int i = 0; i < ANTENNA_COUNT; i++) {
+    positions_xyz[3*i + 0] = 700.0*sin(2.3*i);
+    positions_xyz[3*i + 1] = 700.0*cos(1.1*i);
+    positions_xyz[3*i + 2] = 300.0*sin(0.3*i);
+  }
+  for (int b = 0; b < BEAM_COUNT; b++) {
+    ra[b] = (8.3 + 30.0*b)*RADIOINTERFEROMETERY_PI/180;
+    dec[b] = (16.3 + 10.0*b)*RADIOINTERFEROMETERY_PI/180;
+  }
+  calc_site_t site;
+  calc_site_init(&site, longitude, latitude, altitude, NULL);
+
+  // the reference, advanced through the same dates
+  calc_tracking_session_t session;
+  calc_tracking_session_init(&session, &site, positions_xyz, ANTENNA_COUNT, 0, ra, dec, BEAM_COUNT, NULL, dut1, 1.0);
+
+  calc_delay_producer_t producer;
+  // a non-positive step or a negative lead is rejected before anything starts
+  const double bad_arguments[][2] = {{0.0, 0.1}, {-1.0, 0.1}, {NAN, 0.1}, {step_seconds, -0.1}};
+  for (int b = 0; b < 4; b++) {
+    rv = calc_delay_producer_start(
+      &producer, &site,
+      positions_xyz, ANTENNA_COUNT, 0,
+      ra, dec, BEAM_COUNT,
+      NULL, dut1, 1.0,
+      date1, date2, bad_arguments[b][0],
+      bad_arguments[b][1], 16
+    );
+    if (rv != -1) {
+      printf("step %f, lead %f: return code %d, not -1\n", bad_arguments[b][0], bad_arguments[b][1], rv);
+      failures++;
+    }
+  }
+
+  rv = calc_delay_producer_start(
+    &producer, &site,
+    positions_xyz, ANTENNA_COUNT, 0,
+    ra, dec, BEAM_COUNT,
+    NULL, dut1, 1.0,
+    date1, date2, step_seconds,
+    0.1, 16
+  );
+  if (rv != 0) {
+    printf("start return code: %d\n", rv);
+    return rv;
+  }
+
+  if (calc_delay_producer_poll(&producer, date1, date2 - 1.0/RADIOINTERFEROMETERY_DAYSEC, &delays) != 2) {
+    printf("a date before the first set was not rejected\n");
+    failures++;
+  }
+
+  for (int k = 0; k < SET_COUNT; k++) {
+    // midway through the set
+    double poll_date2 = date2 + (k + 0.5)*step_seconds/RADIOINTERFEROMETERY_DAYSEC;
+    while ((rv = calc_delay_producer_poll(&producer, date1, poll_date2, &delays)) == 1 && waits < 10000) {
+      waits++;
+      nanosleep(&wait, NULL);
+    }
+    if (rv != 0) {
+      printf("set %d: poll return code %d\n", k, rv);
+      failures++;
+      break;
+    }
+    calc_tracking_session_advance(&session, date1, date2 + k*step_seconds/RADIOINTERFEROMETERY_DAYSEC);
+    const double* expected = calc_tracking_session_get_delays(&session);
+    for (int i = 0; i < BEAM_COUNT*ANTENNA_COUNT; i++) {
+      if (delays[i] != expected[i]) {
+        printf("set %d, delay %d: %e != %e\n", k, i, delays[i], expected[i]);
+        failures++;
+      }
+    }
+  }
+
+  // far beyond the lead: an underrun
+  if (calc_delay_producer_poll(&producer, date1, date2 + 1000.0/RADIOINTERFEROMETERY_DAYSEC, &delays) != 1) {
+    printf("a set beyond the lead was not an underrun\n");
+    failures++;
+  }
+  calc_delay_producer_counters(&producer, &produced, &underruns, &status);
+  if (underruns != waits + 1 || produced < SET_COUNT || status != 0) {
+    printf("counters: produced %lu, underruns %lu (expected %lu), status %d\n", produced, underruns, waits + 1, status);
+    failures++;
+  }
+
+  calc_delay_producer_stop(&producer);
+  calc_tracking_session_free(&session);
+  printf("failures: %d\n", failures);
+  return failures;
+}
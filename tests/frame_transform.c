@@ -0,0 +1,80 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "radiointerferometryc99.h"
+
+#define POSITION_COUNT 37
+
+static int compare(const char* name, const double* a, const double* b, double tolerance) {
+  int failures = 0;
+  for (int i = 0; i < 3*POSITION_COUNT; i++) {
+    if (fabs(a[i] - b[i]) > tolerance) {
+      printf("%s: position %d[%d]: %.17g != %.17g\n", name, i/3, i%3, a[i], b[i]);
+      failures++;
+    }
+  }
+  return failures;
+}
+
+int main(int argc, const char * argv[]) {
+  double latitude = 33.97391383157283*RADIOINTERFEROMETERY_PI/180.0;
+  double longitude = -116.5833461618117*RADIOINTERFEROMETERY_PI/180.0;
+  double altitude = 1073.4610445341686;
+  double hour_angle = 0.7, declination = -0.4;
+  double positions_enu[3*POSITION_COUNT], positions[3*POSITION_COUNT], expected[3*POSITION_COUNT];
+  for (int i = 0; i < 3*POSITION_COUNT; i++) {
+    positions_enu[i] = 3000.0*sin(1.7*i) + (i%3 == 2 ? 10.0 : 0.0);
+  }
+
+  calc_frame_transform_t transform, step;
+  int failures = 0;
+
+  // ENU -> ECEF in one pass against the chained functions, as ECEF: nanometres
+  memcpy(positions, positions_enu, sizeof(positions));
+  calc_frame_transform_to_ecef_from_enu(&transform, longitude, latitude, altitude);
+  calc_frame_transform_apply(&transform, positions, POSITION_COUNT);
+  memcpy(expected, positions_enu, sizeof(expected));
+  calc_position_to_xyz_frame_from_enu(expected, POSITION_COUNT, longitude, latitude, altitude);
+  calc_position_to_ecef_frame_from_xyz(expected, POSITION_COUNT, longitude, latitude, altitude);
+  failures += compare("ecef_from_enu", positions, expected, 1e-8);
+
+  // and back, the translation preceding the rotation
+  double positions_ecef[3*POSITION_COUNT];
+  memcpy(positions_ecef, positions, sizeof(positions_ecef));
+  calc_frame_transform_to_enu_from_ecef(&transform, longitude, latitude, altitude);
+  calc_frame_transform_apply(&transform, positions, POSITION_COUNT);
+  failures += compare("enu_from_ecef", positions, positions_enu, 1e-8);
+
+  // ECEF -> UVW, composed for a source, against the chained functions
+  calc_frame_transform_to_xyz_from_ecef(&transform, longitude, latitude, altitude);
+  calc_frame_transform_to_uvw_from_xyz(&step, hour_angle, declination, longitude);
+  calc_frame_transform_compose(&transform, &transform, &step);
+  memcpy(positions, positions_ecef, sizeof(positions));
+  calc_frame_transform_apply(&transform, positions, POSITION_COUNT);
+  memcpy(expected, positions_ecef, sizeof(expected));
+  calc_position_to_xyz_frame_from_ecef(expected, POSITION_COUNT, longitude, latitude, altitude);
+  calc_position_to_uvw_frame_from_xyz(expected, POSITION_COUNT, hour_angle, declination, longitude);
+  failures += compare("uvw_from_ecef", positions, expected, 1e-8);
+
+  // ENU -> UVW directly, and through XYZ
+  calc_frame_transform_to_xyz_from_enu(&transform, longitude, latitude, altitude);
+  calc_frame_transform_compose(&transform, &transform, &step);
+  memcpy(positions, positions_enu, sizeof(positions));
+  calc_frame_transform_apply(&transform, positions, POSITION_COUNT);
+  calc_frame_transform_to_uvw_from_enu(&step, hour_angle, declination, latitude);
+  memcpy(expected, positions_enu, sizeof(expected));
+  calc_frame_transform_apply(&step, expected, POSITION_COUNT);
+  failures += compare("uvw_from_enu", positions, expected, 1e-9);
+
+  // the identity is neutral
+  calc_frame_transform_identity(&step);
+  calc_frame_transform_compose(&step, &step, &transform);
+  if (memcmp(&step, &transform, sizeof(transform)) != 0) {
+    printf("identity: composition changed the transform\n");
+    failures++;
+  }
+
+  printf("failures: %d\n", failures);
+  return failures;
+}
@@ -0,0 +1,59 @@
+#include <stdio.h>
+#include <math.h>
+
+#include "radiointerferometryc99.h"
+
+#define BLOCK_COUNT 4096
+
+int main(int argc, const char * argv[]) {
+  // 0.5 microsecond samples, 8192 samples of 32 packets per block
+  const double tbin = 0.5e-6;
+  const size_t sampleperblk = 8192;
+  const size_t piperblk = 32;
+  // shortly before a UTC midnight (and a Julian noon later)
+  const size_t synctime = 1700000000 - 1700000000 % 86400 + 86400 - 1;
+  const size_t pktidx_start = 123456;
+  size_t pktidx[BLOCK_COUNT];
+  double jd_day[BLOCK_COUNT], jd_fraction[BLOCK_COUNT];
+  double mjd_day[BLOCK_COUNT], mjd_fraction[BLOCK_COUNT];
+  double expected, offset, single;
+  int failures = 0;
+
+  for (int i = 0; i < BLOCK_COUNT; i++) {
+    pktidx[i] = pktidx_start + (size_t)i*piperblk*400;
+  }
+  calc_julian_dates_from_guppi_param(tbin, sampleperblk, piperblk, synctime, pktidx, BLOCK_COUNT, jd_day, jd_fraction);
+  calc_modified_julian_dates_from_guppi_param(tbin, sampleperblk, piperblk, synctime, pktidx, BLOCK_COUNT, mjd_day, mjd_fraction);
+
+  for (int i = 0; i < BLOCK_COUNT; i++) {
+    if (
+      jd_day[i] != floor(jd_day[i]) || !(jd_fraction[i] >= 0.0 && jd_fraction[i] < 1.0)
+      || mjd_day[i] != floor(mjd_day[i]) || !(mjd_fraction[i] >= 0.0 && mjd_fraction[i] < 1.0)
+    ) {
+      printf("block %d: not (integer day, fraction) pairs: (%f, %f), (%f, %f)\n", i, jd_day[i], jd_fraction[i], mjd_day[i], mjd_fraction[i]);
+      failures++;
+    }
+
+    // consistent with the single double form
+    single = calc_julian_date_from_guppi_param(tbin, sampleperblk, piperblk, synctime, pktidx[i]);
+    if (fabs((jd_day[i] - single) + jd_fraction[i]) > 1e-9) {
+      printf("block %d: JD %f + %.15f != %f\n", i, jd_day[i], jd_fraction[i], single);
+      failures++;
+    }
+    if (fabs(((jd_day[i] - mjd_day[i] - 2400000.0) + (jd_fraction[i] - mjd_fraction[i])) - 0.5) > 1e-15) {
+      printf("block %d: JD (%f, %.15f) != MJD (%f, %.15f) + 2400000.5\n", i, jd_day[i], jd_fraction[i], mjd_day[i], mjd_fraction[i]);
+      failures++;
+    }
+
+    // the seconds since the sync-day resolve to nanoseconds
+    offset = ((double) pktidx[i])*tbin*sampleperblk/piperblk;
+    expected = (double) (synctime % 86400) + offset;
+    if (fabs(((mjd_day[i] - 40587.0 - (double) (synctime / 86400))*86400.0 + mjd_fraction[i]*86400.0) - expected) > 1e-9) {
+      printf("block %d: MJD (%f, %.15f) does not resolve %.12f s\n", i, mjd_day[i], mjd_fraction[i], expected);
+      failures++;
+    }
+  }
+
+  printf("failures: %d\n", failures);
+  return failures;
+}
@@ -0,0 +1,39 @@
+#include <stdio.h>
+#include <math.h>
+
+#include "radiointerferometryc99.h"
+
+#define SOURCE_COUNT 64
+
+int main(int argc, const char * argv[]) {
+  double latitude = 33.97391383157283*RADIOINTERFEROMETERY_PI/180.0;
+  double longitude = -116.5833461618117*RADIOINTERFEROMETERY_PI/180.0;
+  double altitude = 1073.4610445341686;
+  double time_jd = 2400000.5+60000.25;
+  double dut1 = -0.0153;
+  double tolerance = 1e-12;
+
+  double ra[SOURCE_COUNT], dec[SOURCE_COUNT];
+  double ha[SOURCE_COUNT], dec_out[SOURCE_COUNT];
+  for (int i = 0; i < SOURCE_COUNT; i++) {
+    ra[i] = i*2*RADIOINTERFEROMETERY_PI/SOURCE_COUNT;
+    dec[i] = (-60.0 + 150.0*i/SOURCE_COUNT)*RADIOINTERFEROMETERY_PI/180;
+  }
+
+  eraASTROM astrom;
+  calc_independent_astrom(longitude, latitude, altitude, time_jd, dut1, &astrom);
+  calc_ha_dec_rad_batch_with_independent_astrom(ra, dec, SOURCE_COUNT, &astrom, ha, dec_out);
+
+  double expected_ha, expected_dec, error;
+  int failures = 0;
+  for (int i = 0; i < SOURCE_COUNT; i++) {
+    calc_ha_dec_rad_with_independent_astrom(ra[i], dec[i], &astrom, &expected_ha, &expected_dec);
+    error = hypot(eraAnpm(ha[i] - expected_ha)*cos(expected_dec), dec_out[i] - expected_dec);
+    if (error > tolerance) {
+      printf("source %d: error %e rad exceeds %e rad\n", i, error, tolerance);
+      failures++;
+    }
+  }
+
+  return failures;
+}
@@ -0,0 +1,78 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "radiointerferometryc99.h"
+
+int main(int argc, const char * argv[]) {
+  const char* cache_filepath = argv[2];
+  unlink(cache_filepath);
+
+  radiointerferometry_iers_table_t iers_table = {0};
+  radiointerferometry_iers_table_t cached_table = {0};
+  int rv = radiointerferometry_iers_table_load(argv[1], &iers_table);
+  if (rv != 0) {
+    printf("load return code: %d\n", rv);
+    return rv;
+  }
+
+  // absent, so written then mapped
+  rv = radiointerferometry_iers_table_open_cache(argv[1], cache_filepath, &cached_table);
+  printf("open_cache return code: %d\n", rv);
+  if (rv != 0) {
+    return rv;
+  }
+  int mismatches = 0;
+  if (
+    cached_table.mjd_start != iers_table.mjd_start
+    || cached_table.record_count != iers_table.record_count
+  ) {
+    printf("cached table spans differently\n");
+    mismatches++;
+  }
+  for (int column = 0; mismatches == 0 && column < RADIOINTERFEROMETRY_IERS_COLUMN_COUNT; column++) {
+    if (memcmp(cached_table.columns[column], iers_table.columns[column], iers_table.record_count*sizeof(double)) != 0) {
+      printf("cached column %d differs\n", column);
+      mismatches++;
+    }
+  }
+
+  radiointerferometry_iers_record_t table_rec = {0}, cached_rec = {0};
+  table_rec.mjd = cached_rec.mjd = 60709.5;
+  radiointerferometry_iers_table_get(&iers_table, &table_rec);
+  radiointerferometry_iers_table_get(&cached_table, &cached_rec);
+  if (memcmp(&table_rec, &cached_rec, sizeof(table_rec)) != 0) {
+    printf("cached record differs\n");
+    mismatches++;
+  }
+  radiointerferometry_iers_table_free(&cached_table);
+
+  // invalidate the cache, it must be rewritten
+  radiointerferometry_iers_cache_header_t header;
+  FILE* cache_file = fopen(cache_filepath, "r+b");
+  if (cache_file == NULL || fread(&header, sizeof(header), 1, cache_file) != 1) {
+    printf("could not read the cache header\n");
+    return 1;
+  }
+  header.source_mtime_sec -= 1;
+  fseek(cache_file, 0, SEEK_SET);
+  fwrite(&header, sizeof(header), 1, cache_file);
+  fclose(cache_file);
+
+  rv = radiointerferometry_iers_table_open_cache(argv[1], cache_filepath, &cached_table);
+  printf("stale open_cache return code: %d\n", rv);
+  if (rv != 0) {
+    return rv;
+  }
+  const radiointerferometry_iers_cache_header_t* mapped_header = cached_table._storage;
+  if (mapped_header->source_mtime_sec == header.source_mtime_sec) {
+    printf("stale cache was not rewritten\n");
+    mismatches++;
+  }
+  radiointerferometry_iers_table_free(&cached_table);
+  radiointerferometry_iers_table_free(&iers_table);
+  unlink(cache_filepath);
+
+  printf("mismatches: %d\n", mismatches);
+  return mismatches;
+}
@@ -0,0 +1,126 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "radiointerferometryc99.h"
+
+static char snippet[64*188];
+static size_t snippet_size;
+
+// write aside then rename, as IERS files are updated
+static int write_snippet(const char* filepath, size_t size) {
+  char temporary_filepath[4096];
+  snprintf(temporary_filepath, sizeof(temporary_filepath), "%s.tmp", filepath);
+  FILE* file = fopen(temporary_filepath, "wb");
+  if (file == NULL || fwrite(snippet, 1, size, file) != size) {
+    return 1;
+  }
+  fclose(file);
+  return rename(temporary_filepath, filepath);
+}
+
+typedef struct {
+  radiointerferometry_iers_handle_t* handle;
+  int stop; // atomic
+  size_t lookups;
+  size_t errors;
+} reader_t;
+
+static void* reader(void* reader_void) {
+  reader_t* r = reader_void;
+  radiointerferometry_iers_record_t record;
+  const radiointerferometry_iers_table_t* table;
+  unsigned ticket;
+  while (!__atomic_load_n(&r->stop, __ATOMIC_RELAXED)) {
+    table = radiointerferometry_iers_handle_acquire(r->handle, &ticket);
+    record.mjd = table->mjd_start + 0.5;
+    if (radiointerferometry_iers_table_get(table, &record) != 0 || record.year != 1973) {
+      r->errors++;
+    }
+    radiointerferometry_iers_handle_release(r->handle, ticket);
+
+    record.mjd = 60709.5;
+    if (radiointerferometry_iers_handle_get(r->handle, &record) != 0) {
+      r->errors++;
+    }
+    r->lookups += 2;
+  }
+  return NULL;
+}
+
+static size_t record_count_of(radiointerferometry_iers_handle_t* handle) {
+  unsigned ticket;
+  size_t record_count = radiointerferometry_iers_handle_acquire(handle, &ticket)->record_count;
+  radiointerferometry_iers_handle_release(handle, ticket);
+  return record_count;
+}
+
+int main(int argc, const char * argv[]) {
+  const char* filepath = argv[2];
+  FILE* file = fopen(argv[1], "rb");
+  if (file == NULL) {
+    return 1;
+  }
+  snippet_size = fread(snippet, 1, sizeof(snippet), file);
+  fclose(file);
+  if (write_snippet(filepath, snippet_size) != 0) {
+    return 1;
+  }
+
+  radiointerferometry_iers_handle_t handle;
+  int rv = radiointerferometry_iers_handle_init(&handle, filepath);
+  printf("init return code: %d\n", rv);
+  if (rv != 0) {
+    return rv;
+  }
+  size_t record_count = record_count_of(&handle);
+
+  reader_t readers[4];
+  pthread_t reader_threads[4];
+  for (int i = 0; i < 4; i++) {
+    memset(&readers[i], 0, sizeof(reader_t));
+    readers[i].handle = &handle;
+    pthread_create(&reader_threads[i], NULL, reader, &readers[i]);
+  }
+
+  // explicit reloads, alternating the last record
+  int failures = 0;
+  for (int i = 0; i < 50; i++) {
+    write_snippet(filepath, snippet_size - (i%2)*188);
+    rv = radiointerferometry_iers_handle_reload(&handle);
+    if (rv != 0) {
+      printf("reload %d return code: %d\n", i, rv);
+      failures++;
+    }
+  }
+
+  // watched reload, dropping the last record
+  radiointerferometry_iers_handle_watch(&handle, 0.01);
+  const struct timespec mtime_resolution = {0, 20000000};
+  nanosleep(&mtime_resolution, NULL);
+  write_snippet(filepath, snippet_size - 188);
+  const struct timespec poll = {0, 10000000};
+  for (int i = 0; i < 200 && record_count_of(&handle) == record_count; i++) {
+    nanosleep(&poll, NULL);
+  }
+  if (record_count_of(&handle) != record_count - 1) {
+    printf("watcher did not reload\n");
+    failures++;
+  }
+
+  size_t lookups = 0;
+  for (int i = 0; i < 4; i++) {
+    __atomic_store_n(&readers[i].stop, 1, __ATOMIC_RELAXED);
+    pthread_join(reader_threads[i], NULL);
+    lookups += readers[i].lookups;
+    failures += readers[i].errors;
+  }
+  radiointerferometry_iers_handle_free(&handle);
+  unlink(filepath);
+
+  printf("lookups: %ld\n", lookups);
+  printf("failures: %d\n", failures);
+  return failures;
+}
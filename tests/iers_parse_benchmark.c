@@ -0,0 +1,252 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "radiointerferometryc99.h"
+
+// internal to src/iers.c
+int _iers_record_parse(
+  const char* char_record,
+  radiointerferometry_iers_record_t* record
+);
+double _iers_record_decode(
+  const char* char_record,
+  uint32_t column_mask,
+  double values[RADIOINTERFEROMETRY_IERS_COLUMN_COUNT]
+);
+
+// The `strtol`/`strtod` parser that the fixed-width decoder replaced.
+int _iers_record_parse_strtod(
+  char* char_record,
+  radiointerferometry_iers_record_t* record
+) {
+  char* char_record_end;
+  
+  char_record_end = char_record+2;
+  record->year = strtol(
+    char_record+1-1,
+    &char_record_end,
+    10
+  );
+  
+  char_record_end = char_record+4;
+  record->month = strtol(
+    char_record+3-1,
+    &char_record_end,
+    10
+  );
+  
+  char_record_end = char_record+6;
+  record->day = strtol(
+    char_record+5-1,
+    &char_record_end,
+    10
+  );
+
+  char_record_end = char_record+15;
+  record->mjd = strtod(
+    char_record+8-1,
+    &char_record_end
+  );
+  record->year += record->mjd < 51544.0 ? 1900 : 2000;
+
+  record->polpmflag_a = char_record[17-1] != 'I';
+
+  char_record_end = char_record+27;
+  record->pm_x_a = strtod(
+    char_record+19-1,
+    &char_record_end
+  );
+
+  char_record_end = char_record+36;
+  record->e_pm_x_a = strtod(
+    char_record+28-1,
+    &char_record_end
+  );
+
+  char_record_end = char_record+46;
+  record->pm_y_a = strtod(
+    char_record+38-1,
+    &char_record_end
+  );
+
+  char_record_end = char_record+55;
+  record->e_pm_y_a = strtod(
+    char_record+47-1,
+    &char_record_end
+  );
+  record->ut1flag_a = char_record[58-1] != 'I';
+
+  char_record_end = char_record+68;
+  record->ut1_utc_a = strtod(
+    char_record+59-1,
+    &char_record_end
+  );
+
+  char_record_end = char_record+78;
+  record->e_ut1_utc_a = strtod(
+    char_record+69-1,
+    &char_record_end
+  );
+
+  char_record_end = char_record+86;
+  record->lod_a = strtod(
+    char_record+80-1,
+    &char_record_end
+  );
+
+  char_record_end = char_record+93;
+  record->e_lod_a = strtod(
+    char_record+87-1,
+    &char_record_end
+  );
+  record->nutflag_a = char_record[96-1] != 'I';
+
+  char_record_end = char_record+106;
+  record->dx_2000a_a = strtod(
+    char_record+98-1,
+    &char_record_end
+  );
+
+  char_record_end = char_record+115;
+  record->e_dx_2000a_a = strtod(
+    char_record+107-1,
+    &char_record_end
+  );
+
+  char_record_end = char_record+125;
+  record->dy_2000a_a = strtod(
+    char_record+117-1,
+    &char_record_end
+  );
+
+  char_record_end = char_record+134;
+  record->e_dy_2000a_a = strtod(
+    char_record+126-1,
+    &char_record_end
+  );
+
+  char_record_end = char_record+144;
+  record->pm_x_b = strtod(
+    char_record+135-1,
+    &char_record_end
+  );
+
+  char_record_end = char_record+154;
+  record->pm_y_b = strtod(
+    char_record+145-1,
+    &char_record_end
+  );
+
+  char_record_end = char_record+165;
+  record->ut1_utc_b = strtod(
+    char_record+155-1,
+    &char_record_end
+  );
+
+  char_record_end = char_record+175;
+  record->dx_2000a_b = strtod(
+    char_record+166-1,
+    &char_record_end
+  );
+
+  char_record_end = char_record+185;
+  record->dy_2000a_b = strtod(
+    char_record+176-1,
+    &char_record_end
+  );
+  return 0;
+}
+
+static double _elapsed(struct timespec* start) {
+  struct timespec stop;
+  clock_gettime(CLOCK_MONOTONIC, &stop);
+  return (stop.tv_sec - start->tv_sec) + (stop.tv_nsec - start->tv_nsec)*1e-9;
+}
+
+int main(int argc, const char * argv[]) {
+  FILE* file = fopen(argv[1], "r");
+  if (file == NULL) {
+    return 1;
+  }
+  // each record is NUL terminated, so neither parser reads past it
+  char char_records[64][188+1];
+  size_t record_count = 0;
+  while (record_count < 64 && fgets(char_records[record_count], sizeof(char_records[0]), file) != NULL) {
+    if (strlen(char_records[record_count]) >= 187) {
+      char_records[record_count][187] = '\0';
+      record_count++;
+    }
+  }
+  fclose(file);
+
+  int mismatches = 0;
+  radiointerferometry_iers_record_t strtod_rec, decoded_rec;
+  for (size_t i = 0; i < record_count; i++) {
+    memset(&strtod_rec, 0, sizeof(strtod_rec));
+    memset(&decoded_rec, 0, sizeof(decoded_rec));
+    _iers_record_parse_strtod(char_records[i], &strtod_rec);
+    _iers_record_parse(char_records[i], &decoded_rec);
+    // `strtol` is not bounded by the field width: " 110" (January 10th)
+    // reads as month 110, the month is compared as its own field
+    if (decoded_rec.month != strtol((char[3]){char_records[i][2], char_records[i][3], '\0'}, NULL, 10)) {
+      printf("record %ld: month %d\n", i, decoded_rec.month);
+      mismatches++;
+    }
+    strtod_rec.month = decoded_rec.month;
+    if (memcmp(&strtod_rec, &decoded_rec, sizeof(strtod_rec)) != 0) {
+      printf("record %ld: decoded record differs from strtod\n", i);
+      mismatches++;
+    }
+  }
+
+  // about the size of a full finals2000A.all
+  const size_t repetitions = 19000/record_count + 1;
+  const size_t passes = 20;
+  double values[RADIOINTERFEROMETRY_IERS_COLUMN_COUNT];
+  double checksum = 0.0;
+  struct timespec start;
+  double elapsed;
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (size_t pass = 0; pass < passes*repetitions; pass++) {
+    for (size_t i = 0; i < record_count; i++) {
+      _iers_record_parse_strtod(char_records[i], &strtod_rec);
+      checksum += strtod_rec.pm_x_a;
+    }
+  }
+  elapsed = _elapsed(&start);
+  printf("strtod:                  %12.0f records/sec\n", passes*repetitions*record_count/elapsed);
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (size_t pass = 0; pass < passes*repetitions; pass++) {
+    for (size_t i = 0; i < record_count; i++) {
+      _iers_record_parse(char_records[i], &decoded_rec);
+      checksum += decoded_rec.pm_x_a;
+    }
+  }
+  elapsed = _elapsed(&start);
+  printf("fixed-width:             %12.0f records/sec\n", passes*repetitions*record_count/elapsed);
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (size_t pass = 0; pass < passes*repetitions; pass++) {
+    for (size_t i = 0; i < record_count; i++) {
+      _iers_record_decode(
+        char_records[i],
+        RADIOINTERFEROMETRY_IERS_COLUMN_MASK(RADIOINTERFEROMETRY_IERS_COLUMN_PM_X_A)
+        | RADIOINTERFEROMETRY_IERS_COLUMN_MASK(RADIOINTERFEROMETRY_IERS_COLUMN_PM_Y_A)
+        | RADIOINTERFEROMETRY_IERS_COLUMN_MASK(RADIOINTERFEROMETRY_IERS_COLUMN_UT1_UTC_A),
+        values
+      );
+      checksum += values[RADIOINTERFEROMETRY_IERS_COLUMN_PM_X_A];
+    }
+  }
+  elapsed = _elapsed(&start);
+  printf("fixed-width (pm, ut1):   %12.0f records/sec\n", passes*repetitions*record_count/elapsed);
+
+  printf("checksum: %f\n", checksum);
+  printf("mismatches: %d\n", mismatches);
+  return mismatches;
+}
@@ -0,0 +1,149 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <float.h>
+
+#include "radiointerferometryc99.h"
+
+int main(int argc, const char * argv[]) {
+  radiointerferometry_iers_table_t iers_table = {0};
+  int rv = radiointerferometry_iers_table_load(argv[1], &iers_table);
+  printf("load return code: %d\n", rv);
+  if (rv != 0) {
+    return rv;
+  }
+  printf("mjd_start: %f, record_count: %ld\n", iers_table.mjd_start, iers_table.record_count);
+
+  // the table must agree with the file accessor, interpolation included
+  radiointerferometry_iers_record_t file_rec, table_rec;
+  int file_rv, table_rv;
+  int mismatches = 0;
+  for (double mjd = iers_table.mjd_start - 1.0; mjd < iers_table.mjd_start + iers_table.record_count + 1.0; mjd += 0.125) {
+    memset(&file_rec, 0, sizeof(file_rec));
+    memset(&table_rec, 0, sizeof(table_rec));
+    file_rec.mjd = mjd;
+    table_rec.mjd = mjd;
+    file_rv = radiointerferometry_iers_get(argv[1], &file_rec);
+    table_rv = radiointerferometry_iers_table_get(&iers_table, &table_rec);
+    if (table_rv == 5) {
+      // the snippet skips the days between its head and tail
+      continue;
+    }
+    if (file_rv != table_rv) {
+      printf("mjd %f: return code %d != %d\n", mjd, file_rv, table_rv);
+      mismatches++;
+    }
+    else if (file_rv == 0 && memcmp(&file_rec, &table_rec, sizeof(file_rec)) != 0) {
+      printf("mjd %f: records differ\n", mjd);
+      mismatches++;
+    }
+  }
+
+  // a product starting at another MJD, like finals2000A.daily
+  FILE* file = fopen(argv[1], "rb");
+  char char_records[64*188];
+  size_t bytes_read = fread(char_records, 1, sizeof(char_records), file);
+  fclose(file);
+  file = fopen(argv[2], "wb");
+  fwrite(char_records + 30*188, 1, bytes_read - 30*188, file);
+  fclose(file);
+  for (double mjd = 60703.75; mjd < 60716.0; mjd += 0.25) {
+    memset(&file_rec, 0, sizeof(file_rec));
+    memset(&table_rec, 0, sizeof(table_rec));
+    file_rec.mjd = mjd;
+    table_rec.mjd = mjd;
+    file_rv = radiointerferometry_iers_get(argv[2], &file_rec);
+    table_rv = radiointerferometry_iers_table_get(&iers_table, &table_rec);
+    if (mjd < 60704.0 ? file_rv != -1 : (file_rv != table_rv || memcmp(&file_rec, &table_rec, sizeof(file_rec)) != 0)) {
+      printf("daily mjd %f: return code %d, records differ\n", mjd, file_rv);
+      mismatches++;
+    }
+  }
+  unlink(argv[2]);
+
+  // batched lookups of a few columns must agree with the record lookups
+  double mjds[64], pm_x[64], pm_y[64], ut1_utc[64];
+  double* columns[RADIOINTERFEROMETRY_IERS_COLUMN_COUNT] = {0};
+  columns[RADIOINTERFEROMETRY_IERS_COLUMN_PM_X_A] = pm_x;
+  columns[RADIOINTERFEROMETRY_IERS_COLUMN_PM_Y_A] = pm_y;
+  columns[RADIOINTERFEROMETRY_IERS_COLUMN_UT1_UTC_A] = ut1_utc;
+  for (int i = 0; i < 64; i++) {
+    mjds[i] = iers_table.mjd_start + i*0.4;
+  }
+  table_rv = radiointerferometry_iers_table_get_many(
+    &iers_table,
+    mjds, 64,
+    RADIOINTERFEROMETRY_IERS_COLUMN_MASK(RADIOINTERFEROMETRY_IERS_COLUMN_PM_X_A)
+    | RADIOINTERFEROMETRY_IERS_COLUMN_MASK(RADIOINTERFEROMETRY_IERS_COLUMN_PM_Y_A)
+    | RADIOINTERFEROMETRY_IERS_COLUMN_MASK(RADIOINTERFEROMETRY_IERS_COLUMN_UT1_UTC_A),
+    columns
+  );
+  if (table_rv != 0) {
+    printf("get_many return code: %d\n", table_rv);
+    mismatches++;
+  }
+  for (int i = 0; table_rv == 0 && i < 64; i++) {
+    table_rec.mjd = mjds[i];
+    radiointerferometry_iers_table_get(&iers_table, &table_rec);
+    if (
+      fabs(pm_x[i] - table_rec.pm_x_a) > 2*DBL_EPSILON*fabs(table_rec.pm_x_a)
+      || fabs(pm_y[i] - table_rec.pm_y_a) > 2*DBL_EPSILON*fabs(table_rec.pm_y_a)
+      || fabs(ut1_utc[i] - table_rec.ut1_utc_a) > 2*DBL_EPSILON*fabs(table_rec.ut1_utc_a)
+    ) {
+      printf("mjd %f: get_many differs\n", mjds[i]);
+      mismatches++;
+    }
+  }
+
+  size_t count = 2;
+  double time_jd[] = {2400000.5+41691.5, 2400000.5+41692.25};
+  double app_ra_radians[] = {8.3*RADIOINTERFEROMETERY_PI/180, 8.3*RADIOINTERFEROMETERY_PI/180};
+  double app_dec_radians[] = {16.3*RADIOINTERFEROMETERY_PI/180, -26.3*RADIOINTERFEROMETERY_PI/180};
+  double pos_angle[2], table_pos_angle[2];
+  double latitude = 33.97391383157283*RADIOINTERFEROMETERY_PI/180.0;
+  double longitude = -116.5833461618117*RADIOINTERFEROMETERY_PI/180.0;
+  double altitude = 1073.4610445341686;
+  double offset_pos = RADIOINTERFEROMETERY_PI/360.0;
+
+  file_rv = calc_itrs_icrs_frame_pos_angle(
+    time_jd, app_ra_radians, app_dec_radians, count,
+    longitude, latitude, altitude, offset_pos,
+    argv[1],
+    pos_angle
+  );
+  table_rv = calc_itrs_icrs_frame_pos_angle_with_iers_table(
+    time_jd, app_ra_radians, app_dec_radians, count,
+    longitude, latitude, altitude, offset_pos,
+    &iers_table,
+    table_pos_angle
+  );
+  for (size_t i = 0; i < count; i++) {
+    printf("posangle %ld: %f (table %f)\n", i, pos_angle[i], table_pos_angle[i]);
+  }
+  if (file_rv != table_rv || memcmp(pos_angle, table_pos_angle, sizeof(pos_angle)) != 0) {
+    printf("posangle: table variant differs (rv %d != %d)\n", file_rv, table_rv);
+    mismatches++;
+  }
+
+  // the caller-owned workspace variant, reusing the workspace
+  double workspace_pos_angle[2];
+  void* workspace = malloc(calc_itrs_icrs_frame_pos_angle_workspace_size(count));
+  for (int repeat = 0; repeat < 2; repeat++) {
+    table_rv = calc_itrs_icrs_frame_pos_angle_with_iers_table_workspace(
+      time_jd, app_ra_radians, app_dec_radians, count,
+      longitude, latitude, altitude, offset_pos,
+      &iers_table,
+      workspace,
+      workspace_pos_angle
+    );
+    if (file_rv != table_rv || memcmp(pos_angle, workspace_pos_angle, sizeof(pos_angle)) != 0) {
+      printf("posangle: workspace variant differs (rv %d != %d)\n", file_rv, table_rv);
+      mismatches++;
+    }
+  }
+  free(workspace);
+
+  radiointerferometry_iers_table_free(&iers_table);
+  printf("mismatches: %d\n", mismatches);
+  return mismatches;
+}
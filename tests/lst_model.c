@@ -0,0 +1,47 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "radiointerferometryc99.h"
+
+// 3 hours at 0.1 second cadence
+#define SAMPLE_COUNT (3*3600*10)
+
+int main(int argc, const char * argv[]) {
+  const double longitude = -116.5833461618117*RADIOINTERFEROMETERY_PI/180.0;
+  const double date1 = 2400000.5 + 60000.25;
+  const double tolerance = 2e-10;
+  double* date2 = malloc(SAMPLE_COUNT*sizeof(double));
+  double* lst = malloc(SAMPLE_COUNT*sizeof(double));
+  double error, max_error = 0.0;
+  int failures = 0;
+
+  for (int i = 0; i < SAMPLE_COUNT; i++) {
+    date2[i] = i*0.1/RADIOINTERFEROMETERY_DAYSEC;
+  }
+
+  calc_lst_model_t model;
+  calc_lst_model_init(&model, longitude, 0);
+  // in blocks, as per spectrum
+  for (int i = 0; i < SAMPLE_COUNT; i += 1000) {
+    calc_lst_model_evaluate(&model, date1, date2 + i, SAMPLE_COUNT - i < 1000 ? SAMPLE_COUNT - i : 1000, lst + i);
+  }
+
+  for (int i = 0; i < SAMPLE_COUNT; i += 7) {
+    error = fabs(eraAnpm(lst[i] - (calc_lst(date1, date2[i]) + longitude)));
+    max_error = error > max_error ? error : max_error;
+    if (error > tolerance) {
+      printf("sample %d: %.12f != %.12f\n", i, lst[i], eraAnp(calc_lst(date1, date2[i]) + longitude));
+      failures++;
+    }
+  }
+  printf("max error: %e rad, reported max deviation: %e rad (tolerance %e rad), %lu anchors\n", max_error, model.max_deviation_rad, tolerance, model.anchor_count);
+  if (model.max_deviation_rad > tolerance || model.anchor_count != 3) {
+    printf("unexpected model report\n");
+    failures++;
+  }
+
+  free(date2);
+  free(lst);
+  printf("failures: %d\n", failures);
+  return failures;
+}
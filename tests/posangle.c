@@ -28,7 +28,7 @@ int main(int argc, const char * argv[]) {
     pos_angle
   );
 
-  printf("rv: %d, count: %d\n------------------\n", rv, ((rv/10)-1)/2);
+  printf("rv: %d, count: %d\n------------------\n", rv, (rv/10)-1);
   for (size_t i = 0; i < count; i++)
   {
     printf("posangle %ld: %f\n", i, pos_angle[i]);
@@ -0,0 +1,95 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "radiointerferometryc99.h"
+
+#define COUNT 97
+
+int main(int argc, const char * argv[]) {
+  radiointerferometry_iers_table_t iers_table = {0};
+  int rv = radiointerferometry_iers_table_load(argv[1], &iers_table);
+  if (rv != 0) {
+    printf("load return code: %d\n", rv);
+    return rv;
+  }
+
+  double time_jd[COUNT], app_ra_radians[COUNT], app_dec_radians[COUNT];
+  double pos_angle[COUNT], parallel_pos_angle[COUNT];
+  int status[COUNT];
+  double latitude = 33.97391383157283*RADIOINTERFEROMETERY_PI/180.0;
+  double longitude = -116.5833461618117*RADIOINTERFEROMETERY_PI/180.0;
+  double altitude = 1073.4610445341686;
+  double offset_pos = RADIOINTERFEROMETERY_PI/360.0;
+  // a few sources per time, as for a batch of times x sources
+  for (int i = 0; i < COUNT; i++) {
+    time_jd[i] = 2400000.5 + iers_table.mjd_start + 0.5 + (i/4)*0.75;
+    app_ra_radians[i] = (8.3 + 40.0*(i%4))*RADIOINTERFEROMETERY_PI/180;
+    app_dec_radians[i] = (16.3 - 25.0*(i%4))*RADIOINTERFEROMETERY_PI/180;
+  }
+
+  int failures = 0;
+  rv = calc_itrs_icrs_frame_pos_angle_with_iers_table(
+    time_jd, app_ra_radians, app_dec_radians, COUNT,
+    longitude, latitude, altitude, offset_pos,
+    &iers_table,
+    pos_angle
+  );
+  if (rv != 0) {
+    printf("serial return code: %d\n", rv);
+    failures++;
+  }
+
+  int thread_counts[] = {1, 2, 3, 8, 200};
+  for (int t = 0; t < 5; t++) {
+    // poisoned, so that elements left unwritten differ
+    for (int i = 0; i < COUNT; i++) {
+      parallel_pos_angle[i] = 1e300;
+    }
+    rv = calc_itrs_icrs_frame_pos_angle_with_iers_table_parallel(
+      time_jd, app_ra_radians, app_dec_radians, COUNT,
+      longitude, latitude, altitude, offset_pos,
+      &iers_table,
+      thread_counts[t],
+      parallel_pos_angle,
+      status
+    );
+    for (int i = 0; i < COUNT; i++) {
+      if (status[i] != 0) {
+        rv++;
+      }
+    }
+    if (rv != 0 || memcmp(pos_angle, parallel_pos_angle, sizeof(pos_angle)) != 0) {
+      printf("%d threads: differs from serial (%d errors)\n", thread_counts[t], rv);
+      failures++;
+    }
+  }
+
+  // an element preceding the table errs alone
+  time_jd[40] = 2400000.5 + iers_table.mjd_start - 1.0;
+  for (int i = 0; i < COUNT; i++) {
+    parallel_pos_angle[i] = 1e300;
+  }
+  rv = calc_itrs_icrs_frame_pos_angle_with_iers_table_parallel(
+    time_jd, app_ra_radians, app_dec_radians, COUNT,
+    longitude, latitude, altitude, offset_pos,
+    &iers_table,
+    3,
+    parallel_pos_angle,
+    status
+  );
+  if (rv != 1 || status[40] != 3 || !isnan(parallel_pos_angle[40])) {
+    printf("erroneous element: return %d, status %d\n", rv, status[40]);
+    failures++;
+  }
+  for (int i = 0; i < COUNT; i++) {
+    if (i != 40 && (status[i] != 0 || parallel_pos_angle[i] != pos_angle[i])) {
+      printf("element %d: status %d, differs from serial\n", i, status[i]);
+      failures++;
+    }
+  }
+
+  radiointerferometry_iers_table_free(&iers_table);
+  printf("failures: %d\n", failures);
+  return failures;
+}
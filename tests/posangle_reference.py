@@ -137,4 +137,7 @@ for test_index, test_case in enumerate(static_test_cases):
     )
     print(f"ri: {ri_ret}")
     print(f"uv: {uv_ret}")
+    # pyuvdata evaluates the equation of the origins at the UTC date, the
+    # library at TT along with the rest of the precession-nutation: the
+    # position angles differ by ~1e-9 relative, well within the tolerance
     assert np.isclose(ri_ret, uv_ret, rtol=1e-3), f"Test #{test_index}"
@@ -0,0 +1,67 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "radiointerferometryc99.h"
+
+#define ANTENNA_COUNT 4
+
+static void delays_at(const double* positions_xyz, double hour_angle, double declination, double longitude, double* delays) {
+  double positions[ANTENNA_COUNT*3];
+  memcpy(positions, positions_xyz, sizeof(positions));
+  calc_position_delays(positions, ANTENNA_COUNT, 1, hour_angle, declination, longitude, delays);
+}
+
+int main(int argc, const char * argv[]) {
+  double latitude = 33.97391383157283*RADIOINTERFEROMETERY_PI/180.0;
+  double longitude = -116.5833461618117*RADIOINTERFEROMETERY_PI/180.0;
+  double positions_xyz[ANTENNA_COUNT*3] = {
+    0, 0, 0,
+    1000, 200, 3,
+    -400, 800, 1,
+    3000, -2500, 10,
+  };
+  calc_position_to_xyz_frame_from_enu(positions_xyz, ANTENNA_COUNT, longitude, latitude, 0);
+
+  double positions[ANTENNA_COUNT*3], uvw[ANTENNA_COUNT*3];
+  double delays[ANTENNA_COUNT], rates[ANTENNA_COUNT], accelerations[ANTENNA_COUNT];
+  double expected[ANTENNA_COUNT], before[ANTENNA_COUNT], after[ANTENNA_COUNT];
+  double step = 1.0; // seconds
+  double hour_angle_step = RADIOINTERFEROMETERY_EARTH_ROTATION_RATE*step;
+  int failures = 0;
+  for (double declination = -1.2; declination < 1.5; declination += 0.3) {
+    for (double hour_angle = -3.0; hour_angle < 3.0; hour_angle += 0.7) {
+      memcpy(positions, positions_xyz, sizeof(positions));
+      calc_position_delays_with_rates(positions, ANTENNA_COUNT, 1, hour_angle, declination, longitude, delays, rates, accelerations);
+
+      memcpy(uvw, positions_xyz, sizeof(uvw));
+      calc_position_to_uvw_frame_from_xyz(uvw, ANTENNA_COUNT, hour_angle, declination, longitude);
+      delays_at(positions_xyz, hour_angle, declination, longitude, expected);
+      delays_at(positions_xyz, hour_angle - hour_angle_step, declination, longitude, before);
+      delays_at(positions_xyz, hour_angle + hour_angle_step, declination, longitude, after);
+      // the frame rotation is applied as one matrix, so agrees to a few ulps
+      for (int a = 0; a < ANTENNA_COUNT; a++) {
+        for (int j = 0; j < 3; j++) {
+          if (fabs(positions[3*a+j] - uvw[3*a+j]) > 1e-12) {
+            printf("ha %f, dec %f: uvw %d differs from calc_position_to_uvw_frame_from_xyz\n", hour_angle, declination, a);
+            failures++;
+          }
+        }
+        if (fabs(delays[a] - expected[a]) > 1e-19) {
+          printf("ha %f, dec %f: delay %d differs from calc_position_delays\n", hour_angle, declination, a);
+          failures++;
+        }
+        if (fabs(rates[a] - (after[a] - before[a])/(2*step)) > 1e-17) {
+          printf("ha %f, dec %f: rate %d: %e != %e\n", hour_angle, declination, a, rates[a], (after[a] - before[a])/(2*step));
+          failures++;
+        }
+        if (fabs(accelerations[a] - (after[a] - 2*expected[a] + before[a])/(step*step)) > 1e-18) {
+          printf("ha %f, dec %f: acceleration %d: %e != %e\n", hour_angle, declination, a, accelerations[a], (after[a] - 2*expected[a] + before[a])/(step*step));
+          failures++;
+        }
+      }
+    }
+  }
+
+  printf("failures: %d\n", failures);
+  return failures;
+}
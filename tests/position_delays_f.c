@@ -0,0 +1,61 @@
+#include <stdio.h>
+#include <string.h>
+#include <float.h>
+
+#include "radiointerferometryc99.h"
+
+#define ANTENNA_COUNT 64
+
+int main(int argc, const char * argv[]) {
+  double latitude = 33.97391383157283*RADIOINTERFEROMETERY_PI/180.0;
+  double longitude = -116.5833461618117*RADIOINTERFEROMETERY_PI/180.0;
+  double altitude = 1073.4610445341686;
+  double positions_ecef[ANTENNA_COUNT*3], positions_xyz[ANTENNA_COUNT*3], centre[3];
+  float positions_f[ANTENNA_COUNT*3];
+  double delays[ANTENNA_COUNT];
+  float delays_f[ANTENNA_COUNT];
+  double extent = 0.0, distance;
+
+  // a 5 km wide array, in ECEF
+  for (int i = 0; i < ANTENNA_COUNT; i++) {
+    positions_ecef[3*i + 0] = 2500.0*sin(2.3*i);
+    positions_ecef[3*i + 1] = 2500.0*cos(1.1*i);
+    positions_ecef[3*i + 2] = 5.0*sin(0.3*i);
+    distance = sqrt(
+      positions_ecef[3*i + 0]*positions_ecef[3*i + 0]
+      + positions_ecef[3*i + 1]*positions_ecef[3*i + 1]
+      + positions_ecef[3*i + 2]*positions_ecef[3*i + 2]
+    );
+    extent = distance > extent ? distance : extent;
+  }
+  calc_position_to_ecef_frame_from_enu(positions_ecef, ANTENNA_COUNT, longitude, latitude, altitude);
+  geodesy_t wgs84 = {0};
+  geodesy_from_af_inv(&wgs84, WGS84_A_METERS, WGS84_F_INV);
+  calc_ecef_from_lla(centre, longitude, latitude, altitude, &wgs84);
+
+  double bound = 8*(FLT_EPSILON/2)*extent/RADIOINTERFEROMETERY_C;
+  double error, max_error = 0.0;
+  int failures = 0;
+  for (double hour_angle = -3.0; hour_angle < 3.0; hour_angle += 0.5) {
+    for (double declination = -1.2; declination < 1.5; declination += 0.3) {
+      memcpy(positions_xyz, positions_ecef, sizeof(positions_xyz));
+      calc_position_to_xyz_frame_from_ecef(positions_xyz, ANTENNA_COUNT, longitude, latitude, altitude);
+      calc_position_delays(positions_xyz, ANTENNA_COUNT, 3, hour_angle, declination, longitude, delays);
+
+      calc_positions_relative_f(positions_ecef, ANTENNA_COUNT, centre, positions_f);
+      calc_position_delays_f(positions_f, ANTENNA_COUNT, 3, hour_angle, declination, longitude, delays_f);
+      for (int i = 0; i < ANTENNA_COUNT; i++) {
+        error = fabs(delays_f[i] - delays[i]);
+        max_error = error > max_error ? error : max_error;
+        if (error > bound) {
+          printf("ha %f, dec %f, antenna %d: %e != %e\n", hour_angle, declination, i, delays_f[i], delays[i]);
+          failures++;
+        }
+      }
+    }
+  }
+
+  printf("max error: %e s (bound %e s)\n", max_error, bound);
+  printf("failures: %d\n", failures);
+  return failures;
+}
@@ -0,0 +1,114 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "radiointerferometryc99.h"
+
+#define ARCSEC (RADIOINTERFEROMETERY_PI/(180*3600))
+
+static double max_difference(const double* a, const double* b, int count) {
+  double difference = 0.0;
+  for (int i = 0; i < count; i++) {
+    if (fabs(a[i] - b[i]) > difference) {
+      difference = fabs(a[i] - b[i]);
+    }
+  }
+  return difference;
+}
+
+int main(int argc, const char * argv[]) {
+  double latitude = 33.97391383157283*RADIOINTERFEROMETERY_PI/180.0;
+  double longitude = -116.5833461618117*RADIOINTERFEROMETERY_PI/180.0;
+  double altitude = 1073.4610445341686;
+  double ra = 8.3*RADIOINTERFEROMETERY_PI/180;
+  double dec = 16.3*RADIOINTERFEROMETERY_PI/180;
+  const double time_jd = 2400000.5 + 60000.25, dut1 = -0.0153;
+  double full[4], tier[4], difference, max_error;
+  int failures = 0;
+
+  calc_precession_nutation_t iau2006a, iau2000b, interpolated;
+  calc_precession_nutation_init(&iau2006a, PRECESSION_NUTATION_IAU2006A, 0);
+  calc_precession_nutation_init(&iau2000b, PRECESSION_NUTATION_IAU2000B, 0);
+
+  // the full tier is exactly the functions without a tier
+  if (calc_lst_with_precession_nutation(&iau2006a, time_jd, 0) != calc_lst(time_jd, 0)) {
+    printf("IAU2006A LST differs from calc_lst\n");
+    failures++;
+  }
+  eraASTROM astrom, tier_astrom;
+  double eo, ha, dec_out, tier_ha, tier_dec_out;
+  calc_independent_astrom(longitude, latitude, altitude, time_jd, dut1, &astrom);
+  calc_independent_astrom_with_precession_nutation(&iau2006a, longitude, latitude, altitude, time_jd, 0, dut1, 0, 0, &tier_astrom, &eo);
+  calc_ha_dec_rad_with_independent_astrom(ra, dec, &astrom, &ha, &dec_out);
+  calc_ha_dec_rad_with_independent_astrom(ra, dec, &tier_astrom, &tier_ha, &tier_dec_out);
+  if (fabs(eraAnpm(tier_ha - ha)) > 1e-14 || fabs(tier_dec_out - dec_out) > 1e-14) {
+    printf("IAU2006A astrometry differs from calc_independent_astrom\n");
+    failures++;
+  }
+
+  // IAU 2000B, 1995 to 2050, against the documented bounds of X, Y, s and eo
+  const double iau2000b_bounds[4] = {1.5e-3*ARCSEC, 1.5e-3*ARCSEC, 1e-5*ARCSEC, 4e-3*ARCSEC};
+  const char* names[4] = {"X", "Y", "s", "eo"};
+  double max_errors[4] = {0.0, 0.0, 0.0, 0.0};
+  for (double date = 2449718.5; date < 2469807.5; date += 3.7) {
+    calc_precession_nutation_cip(&iau2006a, date, 0, full+0, full+1, full+2, full+3);
+    calc_precession_nutation_cip(&iau2000b, date, 0, tier+0, tier+1, tier+2, tier+3);
+    for (int v = 0; v < 4; v++) {
+      difference = fabs(full[v] - tier[v]);
+      max_errors[v] = difference > max_errors[v] ? difference : max_errors[v];
+    }
+  }
+  for (int v = 0; v < 4; v++) {
+    printf("IAU2000B %s max error: %e arcsec (bound %e arcsec)\n", names[v], max_errors[v]/ARCSEC, iau2000b_bounds[v]/ARCSEC);
+    if (max_errors[v] > iau2000b_bounds[v]) {
+      printf("IAU2000B %s exceeds its bound\n", names[v]);
+      failures++;
+    }
+  }
+
+  // interpolated, over 3 days, every 7 minutes
+  const double anchor_seconds[] = {900.0, 3600.0};
+  for (int a = 0; a < 2; a++) {
+    const double anchor_days = anchor_seconds[a]/RADIOINTERFEROMETERY_DAYSEC;
+    const double bound = anchor_days*anchor_days/8*0.15*ARCSEC;
+    calc_precession_nutation_init(&interpolated, PRECESSION_NUTATION_INTERPOLATED, anchor_seconds[a]);
+    max_error = 0.0;
+    for (int step = 0; step < 3*24*60/7; step++) {
+      double date2 = step*7*60/RADIOINTERFEROMETERY_DAYSEC;
+      calc_precession_nutation_cip(&iau2006a, time_jd, date2, full+0, full+1, full+2, full+3);
+      calc_precession_nutation_cip(&interpolated, time_jd, date2, tier+0, tier+1, tier+2, tier+3);
+      difference = max_difference(full, tier, 4);
+      max_error = difference > max_error ? difference : max_error;
+    }
+    printf("interpolated (%.0f s anchors) max error: %e arcsec (bound %e arcsec)\n", anchor_seconds[a], max_error/ARCSEC, bound/ARCSEC);
+    if (max_error > bound) {
+      printf("interpolated exceeds its bound\n");
+      failures++;
+    }
+  }
+
+  // the position angle, with the interpolated tier
+  double pos_angle[2], tier_pos_angle[2];
+  double times[2] = {time_jd, time_jd + 0.01}, ras[2] = {ra, ra}, decs[2] = {dec, dec};
+  double pm_x[2] = {0.1, 0.1}, pm_y[2] = {0.3, 0.3}, ut1_utc[2] = {dut1, dut1};
+  double workspace[9*2];
+  calc_precession_nutation_init(&interpolated, PRECESSION_NUTATION_INTERPOLATED, 0);
+  calc_itrs_icrs_frame_pos_angle_with_pm_and_ut1_utc_workspace(
+    times, ras, decs, pm_x, pm_y, ut1_utc, 2,
+    longitude, latitude, altitude, RADIOINTERFEROMETERY_PI/360.0,
+    workspace, pos_angle
+  );
+  calc_itrs_icrs_frame_pos_angle_with_precession_nutation(
+    times, ras, decs, pm_x, pm_y, ut1_utc, 2,
+    longitude, latitude, altitude, RADIOINTERFEROMETERY_PI/360.0,
+    &interpolated, workspace, tier_pos_angle
+  );
+  difference = max_difference(pos_angle, tier_pos_angle, 2);
+  printf("interpolated position angle error: %e rad\n", difference);
+  if (difference > 1e-9) {
+    printf("interpolated position angle differs\n");
+    failures++;
+  }
+
+  printf("failures: %d\n", failures);
+  return failures;
+}
@@ -0,0 +1,116 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <float.h>
+
+#include "radiointerferometryc99.h"
+
+#define POSITION_COUNT 1003
+
+// the per-position rotations that preceded the matrix kernels
+static void rotate_x(double* v, double s, double c) { double y = v[1], z = v[2]; v[1] = c*y - s*z; v[2] = s*y + c*z; }
+static void rotate_y(double* v, double s, double c) { double x = v[0], z = v[2]; v[0] = c*x + s*z; v[2] = -s*x + c*z; }
+static void rotate_z(double* v, double s, double c) { double x = v[0], y = v[1]; v[0] = c*x - s*y; v[1] = s*x + c*y; }
+static void permute(double* v, int shift) {
+  double p[3];
+  for (int r = 0; r < 3; r++) {
+    p[(r+shift)%3] = v[r];
+  }
+  memcpy(v, p, sizeof(p));
+}
+
+// within a few ulps of the largest component, as the kernels round differently (FMA)
+static int compare(const char* name, const double* a, const double* b, int count) {
+  int failures = 0;
+  double scale;
+  for (int i = 0; i < count; i++) {
+    scale = fabs(b[3*i+0]) + fabs(b[3*i+1]) + fabs(b[3*i+2]);
+    for (int j = 0; j < 3; j++) {
+      if (fabs(a[3*i+j] - b[3*i+j]) > 4*DBL_EPSILON*scale) {
+        printf("%s: position %d[%d]: %.17g != %.17g\n", name, i, j, a[3*i+j], b[3*i+j]);
+        failures++;
+      }
+    }
+  }
+  return failures;
+}
+
+int main(int argc, const char * argv[]) {
+  double latitude = 33.97391383157283*RADIOINTERFEROMETERY_PI/180.0;
+  double longitude = -116.5833461618117*RADIOINTERFEROMETERY_PI/180.0;
+  double hour_angle = 0.7, declination = -0.4;
+  double* positions = malloc(POSITION_COUNT*3*sizeof(double));
+  double* rotated = malloc(POSITION_COUNT*3*sizeof(double));
+  double* expected = malloc(POSITION_COUNT*3*sizeof(double));
+  for (int i = 0; i < 3*POSITION_COUNT; i++) {
+    positions[i] = 3000.0*sin(1.7*i) + (i%3 == 2 ? 10.0 : 0.0);
+  }
+
+  int failures = 0;
+  double rotation[3][3] = {
+    {0.36, 0.48, -0.8},
+    {-0.8, 0.6, 0.0},
+    {0.48, 0.64, 0.6},
+  };
+  memcpy(expected, positions, POSITION_COUNT*3*sizeof(double));
+  calc_positions_rotate_with_kernel(expected, POSITION_COUNT, rotation, ROTATION_KERNEL_SCALAR);
+  const char* kernel_names[] = {"scalar", "avx2", "avx512", "neon"};
+  for (int kernel = ROTATION_KERNEL_SCALAR; kernel <= ROTATION_KERNEL_NEON; kernel++) {
+    printf("%s kernel supported: %d\n", kernel_names[kernel], calc_rotation_kernel_supported(kernel));
+    for (int count = POSITION_COUNT - 9; count <= POSITION_COUNT; count++) {
+      memcpy(rotated, positions, POSITION_COUNT*3*sizeof(double));
+      calc_positions_rotate_with_kernel(rotated, count, rotation, kernel);
+      failures += compare(kernel_names[kernel], rotated, expected, count);
+      if (memcmp(rotated + 3*count, positions + 3*count, (POSITION_COUNT-count)*3*sizeof(double)) != 0) {
+        printf("%s: wrote beyond %d positions\n", kernel_names[kernel], count);
+        failures++;
+      }
+    }
+  }
+
+  memcpy(rotated, positions, POSITION_COUNT*3*sizeof(double));
+  memcpy(expected, positions, POSITION_COUNT*3*sizeof(double));
+  calc_position_to_xyz_frame_from_enu(rotated, POSITION_COUNT, longitude, latitude, 0);
+  for (int i = 0; i < POSITION_COUNT; i++) {
+    rotate_x(expected + 3*i, -sin(latitude), cos(latitude));
+    rotate_y(expected + 3*i, sin(longitude), cos(longitude));
+    permute(expected + 3*i, 1);
+  }
+  failures += compare("xyz_from_enu", rotated, expected, POSITION_COUNT);
+
+  memcpy(rotated, positions, POSITION_COUNT*3*sizeof(double));
+  memcpy(expected, positions, POSITION_COUNT*3*sizeof(double));
+  calc_position_to_enu_frame_from_xyz(rotated, POSITION_COUNT, longitude, latitude, 0);
+  for (int i = 0; i < POSITION_COUNT; i++) {
+    rotate_z(expected + 3*i, -sin(longitude), cos(longitude));
+    rotate_y(expected + 3*i, sin(latitude), cos(latitude));
+    permute(expected + 3*i, 2);
+  }
+  failures += compare("enu_from_xyz", rotated, expected, POSITION_COUNT);
+
+  memcpy(rotated, positions, POSITION_COUNT*3*sizeof(double));
+  memcpy(expected, positions, POSITION_COUNT*3*sizeof(double));
+  calc_position_to_uvw_frame_from_enu(rotated, POSITION_COUNT, hour_angle, declination, latitude);
+  for (int i = 0; i < POSITION_COUNT; i++) {
+    rotate_x(expected + 3*i, -sin(latitude), cos(latitude));
+    rotate_y(expected + 3*i, sin(hour_angle), cos(hour_angle));
+    rotate_x(expected + 3*i, sin(declination), cos(declination));
+  }
+  failures += compare("uvw_from_enu", rotated, expected, POSITION_COUNT);
+
+  memcpy(rotated, positions, POSITION_COUNT*3*sizeof(double));
+  memcpy(expected, positions, POSITION_COUNT*3*sizeof(double));
+  calc_position_to_uvw_frame_from_xyz(rotated, POSITION_COUNT, hour_angle, declination, longitude);
+  for (int i = 0; i < POSITION_COUNT; i++) {
+    rotate_z(expected + 3*i, -sin(longitude-hour_angle), cos(longitude-hour_angle));
+    rotate_y(expected + 3*i, sin(declination), cos(declination));
+    permute(expected + 3*i, 2);
+  }
+  failures += compare("uvw_from_xyz", rotated, expected, POSITION_COUNT);
+
+  free(positions);
+  free(rotated);
+  free(expected);
+  printf("failures: %d\n", failures);
+  return failures;
+}
@@ -0,0 +1,76 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "radiointerferometryc99.h"
+
+#define ANTENNA_COUNT 28
+
+static int compare(const char* name, const double* a, const double* b, int count, double tolerance) {
+  int failures = 0;
+  for (int i = 0; i < count; i++) {
+    if (fabs(a[i] - b[i]) > tolerance) {
+      printf("%s[%d]: %.12f != %.12f\n", name, i, a[i], b[i]);
+      failures++;
+    }
+  }
+  return failures;
+}
+
+int main(int argc, const char * argv[]) {
+  double latitude = 33.97391383157283*RADIOINTERFEROMETERY_PI/180.0;
+  double longitude = -116.5833461618117*RADIOINTERFEROMETERY_PI/180.0;
+  double altitude = 1073.4610445341686;
+  double hour_angle = 0.35, declination = 0.8;
+  double positions_enu[ANTENNA_COUNT*3], expected[ANTENNA_COUNT*3], actual[ANTENNA_COUNT*3];
+  double delays_expected[ANTENNA_COUNT], delays_actual[ANTENNA_COUNT];
+  int failures = 0;
+
+  calc_site_t site;
+  calc_site_init(&site, longitude, latitude, altitude, NULL);
+
+  for (int i = 0; i < ANTENNA_COUNT; i++) {
+    positions_enu[3*i + 0] = 800.0*sin(2.3*i);
+    positions_enu[3*i + 1] = 800.0*cos(1.1*i);
+    positions_enu[3*i + 2] = 5.0*sin(0.3*i);
+  }
+
+#define CHECK_FRAME(from, to, tolerance) \
+  memcpy(expected, positions_enu, sizeof(expected)); \
+  memcpy(actual, positions_enu, sizeof(actual)); \
+  calc_position_to_##to##_frame_from_##from(expected, ANTENNA_COUNT, longitude, latitude, altitude); \
+  calc_position_to_##to##_frame_from_##from##_with_site(actual, ANTENNA_COUNT, &site); \
+  failures += compare(#to "_from_" #from, actual, expected, ANTENNA_COUNT*3, tolerance);
+
+  CHECK_FRAME(enu, xyz, 1e-9)
+  CHECK_FRAME(xyz, enu, 1e-9)
+  CHECK_FRAME(enu, ecef, 1e-8)
+  CHECK_FRAME(ecef, enu, 1e-8)
+  CHECK_FRAME(xyz, ecef, 1e-8)
+  CHECK_FRAME(ecef, xyz, 1e-8)
+
+  memcpy(expected, positions_enu, sizeof(expected));
+  memcpy(actual, positions_enu, sizeof(actual));
+  calc_position_to_uvw_frame_from_enu(expected, ANTENNA_COUNT, hour_angle, declination, latitude);
+  calc_position_to_uvw_frame_from_enu_with_site(actual, ANTENNA_COUNT, hour_angle, declination, &site);
+  failures += compare("uvw_from_enu", actual, expected, ANTENNA_COUNT*3, 1e-9);
+
+  memcpy(expected, positions_enu, sizeof(expected));
+  calc_position_to_xyz_frame_from_enu(expected, ANTENNA_COUNT, longitude, latitude, altitude);
+  memcpy(actual, expected, sizeof(actual));
+  calc_position_delays(expected, ANTENNA_COUNT, 2, hour_angle, declination, longitude, delays_expected);
+  calc_position_delays_with_site(actual, ANTENNA_COUNT, 2, hour_angle, declination, &site, delays_actual);
+  failures += compare("uvw_from_xyz", actual, expected, ANTENNA_COUNT*3, 0.0);
+  failures += compare("delays", delays_actual, delays_expected, ANTENNA_COUNT, 0.0);
+
+  // another ellipsoid (GRS80) places the site elsewhere
+  geodesy_t grs80 = {0};
+  double ecef[3];
+  geodesy_from_af_inv(&grs80, 6378137.0, 298.257222101);
+  calc_site_init(&site, longitude, latitude, altitude, &grs80);
+  calc_ecef_from_lla(ecef, longitude, latitude, altitude, &grs80);
+  failures += compare("grs80 ecef", site.ecef, ecef, 3, 0.0);
+  failures += compare("grs80 xyz_from_ecef", site.xyz_from_ecef.pre_translation, (double[3]){-ecef[0], -ecef[1], -ecef[2]}, 3, 0.0);
+
+  printf("failures: %d\n", failures);
+  return failures;
+}
@@ -0,0 +1,94 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "radiointerferometryc99.h"
+
+#define ANTENNA_COUNT 20
+#define BEAM_COUNT 5
+
+int main(int argc, const char * argv[]) {
+  radiointerferometry_iers_table_t iers_table = {0};
+  int rv = radiointerferometry_iers_table_load(argv[1], &iers_table);
+  if (rv != 0) {
+    printf("load return code: %d\n", rv);
+    return rv;
+  }
+
+  double latitude = 33.97391383157283*RADIOINTERFEROMETERY_PI/180.0;
+  double longitude = -116.5833461618117*RADIOINTERFEROMETERY_PI/180.0;
+  double altitude = 1073.4610445341686;
+  double positions_xyz[ANTENNA_COUNT*3], positions_uvw[ANTENNA_COUNT*3];
+  double ra[BEAM_COUNT], dec[BEAM_COUNT];
+  double delays[ANTENNA_COUNT];
+  double hour_angle, declination, dut1, error, max_error = 0.0;
+  // the staleness of the astrometry over its 10 second window (25 microarcseconds
+  // per second) across the 2 km array
+  const double tolerance = 10*25e-6/3600*RADIOINTERFEROMETERY_PI/180*2000/RADIOINTERFEROMETERY_C;
+  const double date1 = 2400000.5 + iers_table.mjd_start + 10.0;
+  int failures = 0;
+
+  for (int i = 0; i < ANTENNA_COUNT; i++) {
+    positions_xyz[3*i + 0] = 700.0*sin(2.3*i);
+    positions_xyz[3*i + 1] = 700.0*cos(1.1*i);
+    positions_xyz[3*i + 2] = 300.0*sin(0.3*i);
+  }
+  for (int b = 0; b < BEAM_COUNT; b++) {
+    ra[b] = (8.3 + 30.0*b)*RADIOINTERFEROMETERY_PI/180;
+    dec[b] = (16.3 + 10.0*b)*RADIOINTERFEROMETERY_PI/180;
+  }
+
+  calc_site_t site;
+  calc_site_init(&site, longitude, latitude, altitude, NULL);
+  calc_tracking_session_t session;
+  rv = calc_tracking_session_init(
+    &session, &site,
+    positions_xyz, ANTENNA_COUNT, 0,
+    ra, dec, BEAM_COUNT,
+    &iers_table, 0.0,
+    10.0
+  );
+  if (rv != 0) {
+    printf("init return code: %d\n", rv);
+    return rv;
+  }
+  const double* session_delays = calc_tracking_session_get_delays(&session);
+
+  // 1 second steps over 2 minutes, re-pointing a beam midway
+  for (int step = 0; step < 120; step++) {
+    double date2 = 0.3 + step/RADIOINTERFEROMETERY_DAYSEC;
+    rv = calc_tracking_session_advance(&session, date1, date2);
+    if (step == 60) {
+      ra[2] += 0.1;
+      calc_tracking_session_set_beam(&session, 2, ra[2], dec[2]);
+      rv |= calc_tracking_session_advance(&session, date1, date2);
+    }
+    if (rv != 0 || calc_tracking_session_get_delays(&session) != session_delays) {
+      printf("step %d: advance return code %d\n", step, rv);
+      failures++;
+      continue;
+    }
+
+    radiointerferometry_iers_record_t record = {.mjd = (date1 - 2400000.5) + date2};
+    radiointerferometry_iers_table_get(&iers_table, &record);
+    dut1 = record.ut1_utc_a;
+    for (int b = 0; b < BEAM_COUNT; b++) {
+      calc_ha_dec_rad_with_two_part_date(ra[b], dec[b], longitude, latitude, altitude, date1, date2, dut1, &hour_angle, &declination);
+      memcpy(positions_uvw, positions_xyz, sizeof(positions_uvw));
+      calc_position_delays(positions_uvw, ANTENNA_COUNT, 0, hour_angle, declination, longitude, delays);
+      for (int i = 0; i < ANTENNA_COUNT; i++) {
+        error = fabs(session_delays[b*ANTENNA_COUNT + i] - delays[i]);
+        max_error = error > max_error ? error : max_error;
+        if (error > tolerance) {
+          printf("step %d, beam %d, antenna %d: %e != %e\n", step, b, i, session_delays[b*ANTENNA_COUNT + i], delays[i]);
+          failures++;
+        }
+      }
+    }
+  }
+  printf("max error: %e s (tolerance %e s)\n", max_error, tolerance);
+
+  calc_tracking_session_free(&session);
+  radiointerferometry_iers_table_free(&iers_table);
+  printf("failures: %d\n", failures);
+  return failures;
+}
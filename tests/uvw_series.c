@@ -0,0 +1,59 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "radiointerferometryc99.h"
+
+#define ANTENNA_COUNT 42
+#define TIME_COUNT 3000
+
+int main(int argc, const char * argv[]) {
+  double longitude = -116.5833461618117*RADIOINTERFEROMETERY_PI/180.0;
+  double positions_xyz[ANTENNA_COUNT*3], positions_uvw[ANTENNA_COUNT*3];
+  double* uvw = malloc(TIME_COUNT*ANTENNA_COUNT*3*sizeof(double));
+  const double declination = 0.6;
+  // 10 second steps
+  const double hour_angle_start = -2.5, hour_angle_step = 10*RADIOINTERFEROMETERY_EARTH_ROTATION_RATE;
+  const int reanchor_intervals[] = {0, 1, 1000};
+  const int thread_counts[] = {1, 4, 3};
+  double extent = 0.0, distance, error, max_error, bound;
+  int failures = 0;
+
+  // a 2 km wide array
+  for (int i = 0; i < ANTENNA_COUNT; i++) {
+    positions_xyz[3*i + 0] = 1000.0*sin(2.3*i);
+    positions_xyz[3*i + 1] = 1000.0*cos(1.1*i);
+    positions_xyz[3*i + 2] = 700.0*sin(0.3*i);
+    distance = calc_hypotenuse(positions_xyz + 3*i, 3);
+    extent = distance > extent ? distance : extent;
+  }
+
+  for (int r = 0; r < 3; r++) {
+    calc_uvw_time_series(
+      positions_xyz, ANTENNA_COUNT,
+      hour_angle_start, hour_angle_step, TIME_COUNT,
+      declination, longitude,
+      reanchor_intervals[r], thread_counts[r],
+      uvw
+    );
+    bound = (reanchor_intervals[r] < 1 ? CALC_UVW_SERIES_REANCHOR_INTERVAL : reanchor_intervals[r])*ldexp(extent, -50);
+    max_error = 0.0;
+    for (int t = 0; t < TIME_COUNT; t++) {
+      memcpy(positions_uvw, positions_xyz, sizeof(positions_uvw));
+      calc_position_to_uvw_frame_from_xyz(positions_uvw, ANTENNA_COUNT, hour_angle_start + t*hour_angle_step, declination, longitude);
+      for (int i = 0; i < ANTENNA_COUNT*3; i++) {
+        error = fabs(uvw[t*ANTENNA_COUNT*3 + i] - positions_uvw[i]);
+        max_error = error > max_error ? error : max_error;
+        if (error > bound) {
+          printf("reanchor %d, time %d, antenna %d[%d]: %f != %f\n", reanchor_intervals[r], t, i/3, i%3, uvw[t*ANTENNA_COUNT*3 + i], positions_uvw[i]);
+          failures++;
+        }
+      }
+    }
+    printf("reanchor interval %d, threads %d: max error %e m (bound %e m)\n", reanchor_intervals[r], thread_counts[r], max_error, bound);
+  }
+
+  free(uvw);
+  printf("failures: %d\n", failures);
+  return failures;
+}
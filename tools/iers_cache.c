@@ -0,0 +1,22 @@
+#include <stdio.h>
+
+#include "radiointerferometryc99.h"
+
+int main(int argc, const char * argv[]) {
+  if (argc < 2 || argc > 3) {
+    fprintf(stderr, "Usage: %s finals2000A.all [cache_filepath]\n", argv[0]);
+    fprintf(stderr, "  Writes the binary cache of an IERS file, by default to the\n");
+    fprintf(stderr, "  IERS filepath suffixed with \".cache\".\n");
+    return 1;
+  }
+
+  radiointerferometry_iers_table_t iers_table = {0};
+  int rv = radiointerferometry_iers_table_open_cache(argv[1], argc == 3 ? argv[2] : NULL, &iers_table);
+  if (rv != 0) {
+    fprintf(stderr, "Error caching %s: %d\n", argv[1], rv);
+    return rv;
+  }
+  printf("Cached %zu records from MJD %f\n", iers_table.record_count, iers_table.mjd_start);
+  radiointerferometry_iers_table_free(&iers_table);
+  return 0;
+}